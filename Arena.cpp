@@ -0,0 +1,54 @@
+#include "Arena.hpp"
+
+Arena::Arena(std::size_t blockSize):
+    _blockSize{blockSize},
+    _block{0},
+    _cur{nullptr},
+    _end{nullptr}
+{}
+
+Arena::~Arena() {
+    runReleases(0);
+}
+
+void *Arena::allocateSlow(std::size_t size, std::size_t align) {
+
+    // Move on to the next block that fits: a rewound one if there is any,
+    // otherwise a fresh one.
+    std::size_t next = _cur == nullptr ? 0 : _block + 1;
+    while (next < _blocks.size() && _blocks[next].size < size + align)
+        next++;
+
+    if (next >= _blocks.size()) {
+        std::size_t blockSize = size + align > _blockSize ? size + align : _blockSize;
+        _blocks.push_back(Block{std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+        next = _blocks.size() - 1;
+    }
+
+    _block = next;
+    _cur = _blocks[next].data.get();
+    _end = _cur + _blocks[next].size;
+    return allocate(size, align);
+}
+
+void Arena::runReleases(std::size_t down) {
+    while (_releases.size() > down) {
+        Release last = _releases.back();
+        _releases.pop_back();
+        last.release(last.object);
+    }
+}
+
+void Arena::rewind(Mark mark) {
+    runReleases(mark.releases);
+    _block = mark.block;
+    _cur = mark.cur;
+    _end = _cur == nullptr ? nullptr : _blocks[_block].data.get() + _blocks[_block].size;
+}
+
+std::size_t Arena::capacity() const {
+    std::size_t total = 0;
+    for (const Block &block : _blocks)
+        total += block.size;
+    return total;
+}
@@ -0,0 +1,120 @@
+#ifndef __ARENA_HPP
+#define __ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Objects in an Arena are never destroyed one by one, so an ArenaPtr owns
+// nothing; it only marks the pointer as belonging to the tree.
+struct NoDelete {
+    template <class T>
+    void operator()(T *) const {}
+};
+
+template <class T>
+using ArenaPtr = std::unique_ptr<T, NoDelete>;
+
+// A bump allocator. Memory comes out of large blocks and is only given back
+// all at once, when the Arena is destroyed or rewound. No destructor runs
+// for what was placed in it, so anything living here must not own memory
+// outside the arena (use ArenaVector rather than std::vector), unless it
+// registers what it owns with onRelease().
+class Arena {
+
+public:
+    explicit Arena(std::size_t blockSize = 64 * 1024);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(std::size_t size, std::size_t align) {
+        std::uintptr_t p = (reinterpret_cast<std::uintptr_t>(_cur) + align - 1) & ~(std::uintptr_t) (align - 1);
+        if (_cur == nullptr || p + size > reinterpret_cast<std::uintptr_t>(_end))
+            return allocateSlow(size, align);
+        _cur = reinterpret_cast<char *>(p + size);
+        return reinterpret_cast<void *>(p);
+    }
+
+    template <class T, class... Args>
+    ArenaPtr<T> make(Args &&... args) {
+        return ArenaPtr<T>(new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...));
+    }
+
+    // Calls release(object) when the arena is rewound to a mark taken
+    // before this call, or destroyed; the latest registered goes first.
+    void onRelease(void (*release)(const void *), const void *object) {
+        _releases.push_back(Release{release, object});
+    }
+
+    // rewind(mark()) drops everything allocated in between. The blocks are
+    // kept for reuse, so a loop that rewinds stays at a constant footprint.
+    struct Mark {
+        std::size_t block;
+        char *cur;
+        std::size_t releases;
+    };
+    Mark mark() const { return Mark{_block, _cur, _releases.size()}; }
+    void rewind(Mark mark);
+
+    // Bytes of block memory held, used or not.
+    std::size_t capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    struct Release {
+        void (*release)(const void *);
+        const void *object;
+    };
+
+    void *allocateSlow(std::size_t size, std::size_t align);
+    void runReleases(std::size_t down);
+
+    std::size_t _blockSize;
+    std::vector<Block> _blocks;
+    std::vector<Release> _releases;
+    std::size_t _block;
+    char *_cur;
+    char *_end;
+};
+
+// Lets standard containers take their storage from an Arena. deallocate()
+// is a no-op; a growing vector leaves its old buffers behind until the
+// arena goes.
+template <class T>
+class ArenaAllocator {
+
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena &arena): _arena{&arena} {}
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U> &other): _arena{other.arena()} {}
+
+    T *allocate(std::size_t n) { return static_cast<T *>(_arena->allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *, std::size_t) {}
+
+    Arena *arena() const { return _arena; }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U> &other) const { return _arena == other.arena(); }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U> &other) const { return _arena != other.arena(); }
+
+private:
+    Arena *_arena;
+};
+
+template <class T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
@@ -1,32 +1,30 @@
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 
 #include "ArithExpr.hpp"
+#include "statements/Statement.hpp"
 #include "DescriptorFunctions.hpp"
-
-void checkTypeCompatibility(std::string scope, TypeDescriptor *t1, TypeDescriptor *t2) {
-    if ( !Descriptor::validTypeOp(t1, t2) ) {
-            std::cout << scope << "-Fatal Error - Operands / Operators not compatible" << std::endl;
-            std::cout << "Operator Enum { INTEGER = 0, DOUBLE = 1, BOOL = 2, STRING = 3 }" << std::endl;
-            std::cout << "LHS Operator: " << t1->type() << "\t RHS Operator: " << t2->type() << std::endl;
-            exit(1);
-        }
-}
+#include "Dispatch.hpp"
+#include "Literals.hpp"
+#include "ProgramCache.hpp"
 
 // ExprNode START
-ExprNode::ExprNode(std::shared_ptr<Token> token): _token{token} {}
+ExprNode::ExprNode(const Token &token):
+    _token{token},
+    _staticType{UNTYPED}
+{}
 
 ExprNode::~ExprNode(){
     if (destructor)
         std::cout << "~ExprNode()" << std::endl;
 }
 
-const std::shared_ptr<Token>& ExprNode::token() { return _token; }
 //ExprNode END
 
 
 // InfixExprNode START
-InfixExprNode::InfixExprNode(std::shared_ptr<Token> tk) : 
+InfixExprNode::InfixExprNode(const Token &tk) : 
     ExprNode{tk}, 
     _left(nullptr), 
     _right(nullptr) 
@@ -47,7 +45,7 @@ void InfixExprNode::dumpAST(std::string space) {
         _right->dumpAST(space + '\t');
 }
 
-std::unique_ptr<TypeDescriptor> InfixExprNode::evaluate(SymTab &symTab) {
+Value InfixExprNode::evaluate(SymTab &symTab) {
     // Evaluates an infix expression using a post-order traversal of the expression tree.
     
     // add later/
@@ -55,18 +53,28 @@ std::unique_ptr<TypeDescriptor> InfixExprNode::evaluate(SymTab &symTab) {
 
         auto lValue = _left->evaluate(symTab);
 
-        if (lValue->type() == TypeDescriptor::INTEGER) {
+        if ( _left->staticType() == TypeDescriptor::INTEGER ) {
+
+            lValue._value.intValue *= -1;
+            return lValue;
+
+        } else if ( _left->staticType() == TypeDescriptor::DOUBLE ) {
+
+            lValue._value.doubleValue *= -1;
+            return lValue;
+
+        } else if (lValue.type() == TypeDescriptor::INTEGER) {
             
-            Descriptor::Int::flipSignBit(lValue.get());
-            return std::move(lValue);
+            Descriptor::Int::flipSignBit(lValue);
+            return lValue;
 
-        } else if (lValue->type() == TypeDescriptor::DOUBLE) {
+        } else if (lValue.type() == TypeDescriptor::DOUBLE) {
 
-            Descriptor::Double::flipSignBit(lValue.get());
-            return std::move(lValue);
+            Descriptor::Double::flipSignBit(lValue);
+            return lValue;
 
         } else {
-            std::cout << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << lValue->type() << std::endl;
+            std::cout << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << lValue.type() << std::endl;
             exit(1);
         }
     }
@@ -75,22 +83,64 @@ std::unique_ptr<TypeDescriptor> InfixExprNode::evaluate(SymTab &symTab) {
     auto rValue = _right->evaluate(symTab);
 
     if (debug)
-        std::cout << "InfixExprNode::evaluate: " << lValue->type() << " " << token()->symbol() << " " << rValue->type() << std::endl;
-     
-    checkTypeCompatibility("InfixExprNode::evaluate()", lValue.get(), rValue.get());
+        std::cout << "InfixExprNode::evaluate: " << lValue.type() << " " << token()->symbol() << " " << rValue.type() << std::endl;
+
+    // Operands of one proven type: same results as their kernels in Dispatch.cpp.
+    if ( _left->staticType() == _right->staticType() ) {
+
+        switch ( _left->staticType() ) {
+
+        case TypeDescriptor::INTEGER:
+            return Descriptor::Int::arithmetic(
+                lValue._value.intValue,
+                rValue._value.intValue,
+                token()
+            );
+
+        case TypeDescriptor::DOUBLE:
+            return Descriptor::Double::createDoubleDescriptor(
+                lValue._value.doubleValue +
+                rValue._value.doubleValue
+            );
+
+        case TypeDescriptor::STRING:
+            // A left operand no one else holds (the result of another
+            // concatenation) is appended to in place.
+            if ( token()->isAdditionOperator() ) {
+                const std::string &rhs = rValue._value.stringValue->_stringValue;
+                std::size_t size = lValue._value.stringValue->_stringValue.size() + rhs.size();
+                lValue.mutableString(size) += rhs;
+                return lValue;
+            }
+            break;
+        }
+    }
 
-   return Descriptor::relOperatorDescriptor(lValue.get(), rValue.get(), token());
+    return Descriptor::binary(lValue, rValue, token());
 }
 
 void InfixExprNode::print() {
+    // Unary minus has no right operand.
+    if ( _right == nullptr ) {
+        token()->print();
+        _left->print();
+        return;
+    }
     _left->print();
     token()->print();
     _right->print();
 }
+
+void InfixExprNode::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::INFIX_EXPR);
+    out.token(*token());
+    out.node(_left.get());
+    out.node(_right.get());
+}
 // InfixExprNode END
 
 // ComparisonExprNode START
- ComparisonExprNode::ComparisonExprNode(std::shared_ptr<Token> tk):
+ ComparisonExprNode::ComparisonExprNode(const Token &tk):
     ExprNode{tk},
     _left{nullptr},
     _right{nullptr}
@@ -105,7 +155,7 @@ void ComparisonExprNode::print() {
     // std::cout << "ComparisonExprNode::print()" << std::endl;
 }
 
-std::unique_ptr<TypeDescriptor> ComparisonExprNode::evaluate(SymTab &symTab) {
+Value ComparisonExprNode::evaluate(SymTab &symTab) {
 
     auto lValue = _left->evaluate(symTab);
     auto rValue = _right->evaluate(symTab);
@@ -113,9 +163,25 @@ std::unique_ptr<TypeDescriptor> ComparisonExprNode::evaluate(SymTab &symTab) {
     if (debug)
         std::cout << "ComparisonExprNode::evaluate:" << std::endl;
 
-    checkTypeCompatibility("ComparisonExprNode::evaluate()", lValue.get(), rValue.get());
+    if ( Descriptor::Unchecked::isNumber(_left->staticType()) && Descriptor::Unchecked::isNumber(_right->staticType()) ) {
 
-    return Descriptor::comparisonDescriptor(lValue.get(), rValue.get(), token());
+        double lhsVar, rhsVar;
+        Descriptor::grabValueFromNumberDescriptor(lhsVar, lValue);
+        Descriptor::grabValueFromNumberDescriptor(rhsVar, rValue);
+
+        return Descriptor::Bool::createBooleanDescriptor(Compare::Number::compNumber(lhsVar, rhsVar, token()));
+    }
+
+    if ( _left->staticType() == TypeDescriptor::STRING && _right->staticType() == TypeDescriptor::STRING ) {
+
+        return Descriptor::Bool::createBooleanDescriptor(Compare::String::compString(
+            lValue._value.stringValue->_stringValue,
+            rValue._value.stringValue->_stringValue,
+            token()
+        ));
+    }
+
+    return Descriptor::binary(lValue, rValue, token());
 
 }
 
@@ -127,10 +193,17 @@ void ComparisonExprNode::dumpAST(std::string space) {
     _left->dumpAST(space + '\t');
     _right->dumpAST(space + '\t');
 }
+
+void ComparisonExprNode::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::COMPARISON_EXPR);
+    out.token(*token());
+    out.node(_left.get());
+    out.node(_right.get());
+}
 // ComparisonExprNode END
 
 // BooleanExprNode START
-BooleanExprNode::BooleanExprNode(std::shared_ptr<Token> tk): 
+BooleanExprNode::BooleanExprNode(const Token &tk): 
     ExprNode{tk}, 
     _left{nullptr}, 
     _right{nullptr} 
@@ -145,7 +218,7 @@ void BooleanExprNode::print() {
     std::cout << "BooleanExprNode::print" << std::endl;
 }
 
-std::unique_ptr<TypeDescriptor> BooleanExprNode::evaluate(SymTab &symTab) {
+Value BooleanExprNode::evaluate(SymTab &symTab) {
     // std::cout << "BooleanExprNode::evaluate" << std::endl;
 
     // NOT always take left route -> _right == nullptr
@@ -153,7 +226,13 @@ std::unique_ptr<TypeDescriptor> BooleanExprNode::evaluate(SymTab &symTab) {
     if ( token()->isNot() ) {
 
         auto result = _left->evaluate(symTab);
-        return Descriptor::negateDescriptor(result.get());
+
+        if ( _left->staticType() == TypeDescriptor::BOOL )
+            return Descriptor::Bool::createBooleanDescriptor( !result._value.boolValue );
+        if ( Descriptor::Unchecked::isNumber(_left->staticType()) )
+            return Descriptor::Bool::createBooleanDescriptor( result._value.intValue == 0 );
+
+        return Descriptor::negateDescriptor(result);
     
     } else if ( token()->isAnd() ) {
 
@@ -165,9 +244,14 @@ std::unique_ptr<TypeDescriptor> BooleanExprNode::evaluate(SymTab &symTab) {
         auto lValue = _left->evaluate(symTab);
         auto rValue = _right->evaluate(symTab);
 
-        checkTypeCompatibility("BooleanExprNode::evaluate()", lValue.get(), rValue.get());
+        // Any two numbers are compatible.
+        if ( Descriptor::Unchecked::isNumber(_left->staticType()) && Descriptor::Unchecked::isNumber(_right->staticType()) )
+            return Descriptor::Bool::createBooleanDescriptor(
+                Descriptor::Unchecked::positive(lValue) &&
+                Descriptor::Unchecked::positive(rValue)
+            );
 
-        return Descriptor::andDescriptor(lValue.get(), rValue.get());
+        return Descriptor::binary(lValue, rValue, token());
 
     } else if ( token()->isOr() ) {
 
@@ -179,15 +263,20 @@ std::unique_ptr<TypeDescriptor> BooleanExprNode::evaluate(SymTab &symTab) {
         auto lValue = _left->evaluate(symTab);
         auto rValue = _right->evaluate(symTab);
 
-        checkTypeCompatibility("BooleanExprNode::evaluate()", lValue.get(), rValue.get());
+        // Any two numbers are compatible.
+        if ( Descriptor::Unchecked::isNumber(_left->staticType()) && Descriptor::Unchecked::isNumber(_right->staticType()) )
+            return Descriptor::Bool::createBooleanDescriptor(
+                Descriptor::Unchecked::positive(lValue) ||
+                Descriptor::Unchecked::positive(rValue)
+            );
 
-        return Descriptor::orDescriptor(lValue.get(), rValue.get());
+        return Descriptor::binary(lValue, rValue, token());
     }
 
     std::cout << "BooleanExprNode::evaluate BAD TOKEN" << std::endl;
     exit(1);
 
-    return nullptr;
+    return Value();
 
 }
 
@@ -197,10 +286,17 @@ void BooleanExprNode::dumpAST(std::string space) {
     token()->print();
     std::cout << std::endl;
 }
+
+void BooleanExprNode::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::BOOLEAN_EXPR);
+    out.token(*token());
+    out.node(_left.get());
+    out.node(_right.get());
+}
 //BooleanExprNode END
 
 // WholeNumber START
-WholeNumber::WholeNumber(std::shared_ptr<Token> token): 
+WholeNumber::WholeNumber(const Token &token): 
     ExprNode{token} 
 {}
 
@@ -213,7 +309,7 @@ void WholeNumber::print() {
     token()->print();
 }
 
-std::unique_ptr<TypeDescriptor> WholeNumber::evaluate(SymTab &symTab) {
+Value WholeNumber::evaluate(SymTab &) {
 
     if (debug) 
         std::cout << "WholeNumber::evaluate: returning " << token()->getWholeNumber() << std::endl;
@@ -229,10 +325,15 @@ void WholeNumber::dumpAST(std::string space) {
     token()->print();
     std::cout << std::endl;
 }
+
+void WholeNumber::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::WHOLE_NUMBER);
+    out.token(*token());
+}
 // WholeNumber END
 
 // Double START
-Double::Double(std::shared_ptr<Token> token):
+Double::Double(const Token &token):
     ExprNode{token}
 {}
 
@@ -245,7 +346,7 @@ void Double::print() {
     token()->print();
 }
 
-std::unique_ptr<TypeDescriptor> Double::evaluate(SymTab &symTab [[maybe_unused]]) {
+Value Double::evaluate(SymTab &symTab [[maybe_unused]]) {
     
     if (debug)
         std::cout << "Double::evaluate: returning " << token()->getFloat() << std::endl;
@@ -258,11 +359,17 @@ void Double::dumpAST(std::string space) {
     token()->print();
     std::cout << std::endl;
 }
+
+void Double::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::DOUBLE);
+    out.token(*token());
+}
 // Double END
 
 // Variable START
-Variable::Variable(std::shared_ptr<Token> token): 
-    ExprNode{token} 
+Variable::Variable(const Token &token): 
+    ExprNode{token},
+    _slotted{false}
 {}
 
 Variable::~Variable() {
@@ -275,14 +382,18 @@ void Variable::print() {
     token()->print();
 }
 
-std::unique_ptr<TypeDescriptor> Variable::evaluate(SymTab &symTab) {
-    if ( !symTab.isDefined(token()->getName()) ) {
+Value Variable::evaluate(SymTab &symTab) {
+    Symbol name = token()->getSymbol();
+    Value *value = _slotted ? &symTab.slot(name)
+                            : symTab.isDefined(name) ? symTab.getValueFor(name) : nullptr;
+
+    if ( value == nullptr || !value->defined() ) {
         std::cout << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
         std::cout << "Use of undefined variable, " << token()->getName() << std::endl;
         exit(1);
     }
 
-    return Descriptor::copyReferencePtr(symTab.getValueFor( token()->getName() ));
+    return *value;
 }
 
 void Variable::dumpAST(std::string space) {
@@ -292,13 +403,43 @@ void Variable::dumpAST(std::string space) {
     std::cout << std::endl;
 }
 
+void Variable::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::VARIABLE);
+    out.token(*token());
+}
+
 // Variable END
 
 // StringExp START
-StringExp::StringExp(std::shared_ptr<Token> token): 
-    ExprNode{token} 
+StringExp::StringExp(const Token &token): 
+    ExprNode{token},
+    _constant{Literals::intern(token.getText())}
+{}
+
+StringExp::StringExp(const Token &token, Arena &owner):
+    StringExp(token, new StringDescriptor(std::string(token.getText())), owner)
 {}
 
+// The token's text may not outlive the Lexer's window; point it at the
+// node's own copy instead.
+static Token withText(Token token, const StringDescriptor *owned) {
+    token.setString(owned->_stringValue);
+    return token;
+}
+
+static void releaseString(const void *owned) {
+    auto string = static_cast<const StringDescriptor *>(owned);
+    if (string->release())
+        delete string;
+}
+
+StringExp::StringExp(const Token &token, const StringDescriptor *owned, Arena &owner):
+    ExprNode{withText(token, owned)},
+    _constant{owned}
+{
+    owner.onRelease(releaseString, owned);
+}
+
 StringExp::~StringExp() {
     if (destructor)
         std::cout << "~StringExp()" << std::endl;
@@ -308,8 +449,8 @@ void StringExp::print() {
     std::cout << "PRINT" << std::endl;
 }
 
-std::unique_ptr<TypeDescriptor> StringExp::evaluate(SymTab &symTab) {
-    return Descriptor::String::createStringDescriptor(token()->getString());
+Value StringExp::evaluate(SymTab &) {
+    return Descriptor::String::createStringConstant(_constant);
 }
 
 void StringExp::dumpAST(std::string space) {
@@ -318,17 +459,47 @@ void StringExp::dumpAST(std::string space) {
     token()->print();
     std::cout << std::endl;
 }
+
+void StringExp::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::STRING_EXP);
+    out.token(*token());
+}
 // StringExp END
 
+// BoolLiteral START
+BoolLiteral::BoolLiteral(const Token &token):
+    ExprNode{token}
+{}
+
+void BoolLiteral::print() {
+    std::cout << (token()->getWholeNumber() ? "True" : "False");
+}
+
+Value BoolLiteral::evaluate(SymTab &symTab [[maybe_unused]]) {
+    return Descriptor::Bool::createBooleanDescriptor( token()->getWholeNumber() != 0 );
+}
+
+void BoolLiteral::dumpAST(std::string space) {
+    std::cout << space << std::setw(15) << std::left << "BoolLiteral " << this << "\tToken: ";
+    print();
+    std::cout << std::endl;
+}
+
+void BoolLiteral::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::BOOL_LITERAL);
+    out.token(*token());
+}
+// BoolLiteral END
 
 //Start FunctionCall
 
-FunctionCall::FunctionCall(std::shared_ptr<Token> functionName, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testList):
+FunctionCall::FunctionCall(const Token &functionName, ArenaPtr<ExprList> testList):
     ExprNode{functionName},
+   _functionName{functionName.getSymbol()},
    _testList{std::move(testList)}
     {}
 
-std::unique_ptr<TypeDescriptor> FunctionCall::evaluate(SymTab &symTab) {
+Value FunctionCall::evaluate(SymTab &symTab) {
 
     //Use _functionNAme to get shared pointer reference to class FunctionDefinition
     // size check
@@ -351,11 +522,11 @@ std::unique_ptr<TypeDescriptor> FunctionCall::evaluate(SymTab &symTab) {
 
     auto functionPointer = symTab.getFunction(_functionName);
 
-    if ( functionPointer->_SUITE_NOT_FUNC_SUITE_FIX->length() != _testList->size()  ) {
+    if ( static_cast<std::size_t>(functionPointer->_SUITE_NOT_FUNC_SUITE_FIX->length()) != _testList->size()  ) {
         std::cout << "Error FunctionCall::evaluate -> Caller Args != Calling Args" << std::endl;
     }
 
-    sumTab.openScope();
+    symTab.openScope();
 
 
     symTab.closeScope();
@@ -364,7 +535,7 @@ std::unique_ptr<TypeDescriptor> FunctionCall::evaluate(SymTab &symTab) {
 
 void FunctionCall::dumpAST(std::string indent) {
 
-    std::cout << indent << "FunctionCall: " << _functionName << " " << this << "\n";
+    std::cout << indent << "FunctionCall: " << Symbols::name(_functionName) << " " << this << "\n";
 
     for_each(_testList->begin(), _testList->end(), [&] (auto &args) {
         args->dumpAST(indent + "\t");
@@ -373,5 +544,11 @@ void FunctionCall::dumpAST(std::string indent) {
 
 void FunctionCall::print() {}
 
+void FunctionCall::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::FUNCTION_CALL);
+    out.token(*token());
+    out.exprList(_testList.get());
+}
+
 
 // End FunctionCall
\ No newline at end of file
@@ -8,131 +8,190 @@
 #include "SymTab.hpp"
 #include "Token.hpp"
 #include "Descriptor.hpp"
+#include "Arena.hpp"
+
+class ProgramWriter;
 
 
 // An ExprNode serves as the base class (super class) for arithmetic expression.
 // It forces the derived classes (subclasses) to implement two functions, print and
 // evaluate.
+//
+// The Parser places every node, and every child list, in an Arena; the tree
+// is freed in one go with it and node destructors never run.
 class ExprNode {
 public:
-    ExprNode(std::shared_ptr<Token> token);
+    ExprNode(const Token &token);
     
     virtual ~ExprNode() = 0;
-    const std::shared_ptr<Token>& token();
+    const Token *token() const { return &_token; }
     virtual void dumpAST(std::string) = 0;
     virtual void print() = 0;
     // virtual TypeDescriptor evaluate(SymTab &) = 0;
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &) = 0;
+    virtual Value evaluate(SymTab &) = 0;
+    // Writes the node and its children for the ProgramCache.
+    virtual void serialize(ProgramWriter &) = 0;
+
+    // The TypeDescriptor::types every evaluation of this node is proven to
+    // produce (passes/Infer.hpp), or UNTYPED. Parents holding typed operands
+    // skip the type checks.
+    static const int UNTYPED = -1;
+    int staticType() const { return _staticType; }
+    void setStaticType(int type) { _staticType = type; }
 
 private:
-    std::shared_ptr<Token> _token;
+    Token _token;
+    int _staticType;
 };
 
 
+using ExprList = ArenaVector<ArenaPtr<ExprNode>>;
+
 // An InfixExprNode is useful to represent binary arithmetic operators.
 class InfixExprNode: public ExprNode {  // An expression tree node.
 
 public:
-    InfixExprNode(std::shared_ptr<Token> tk);
+    InfixExprNode(const Token &tk);
     ~InfixExprNode();
     
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 
 public: 
-    std::unique_ptr<ExprNode> _left;
-    std::unique_ptr<ExprNode> _right;
+    ArenaPtr<ExprNode> _left;
+    ArenaPtr<ExprNode> _right;
 };
 
 class ComparisonExprNode: public ExprNode {
 
 public:
-    ComparisonExprNode(std::shared_ptr<Token> tk);
+    ComparisonExprNode(const Token &tk);
     ~ComparisonExprNode();
 
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 
 public:
-    std::unique_ptr<ExprNode> _left;
-    std::unique_ptr<ExprNode> _right;
+    ArenaPtr<ExprNode> _left;
+    ArenaPtr<ExprNode> _right;
 };
 
 class BooleanExprNode: public ExprNode {
 
 public:
-    BooleanExprNode(std::shared_ptr<Token> tk);
+    BooleanExprNode(const Token &tk);
     ~BooleanExprNode();
 
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 
 public:
-    std::unique_ptr<ExprNode> _left;
-    std::unique_ptr<ExprNode> _right;
+    ArenaPtr<ExprNode> _left;
+    ArenaPtr<ExprNode> _right;
 };
 
 class WholeNumber: public ExprNode {
 public:
-    WholeNumber(std::shared_ptr<Token> token);
+    WholeNumber(const Token &token);
     ~WholeNumber();
 
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 };
 
 class Double: public ExprNode {
 public:
-    Double(std::shared_ptr<Token>);
+    Double(const Token &);
     ~Double();
 
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 };
 
 class Variable: public ExprNode {
 public:
-    Variable(std::shared_ptr<Token> token);
+    Variable(const Token &token);
     ~Variable();
     
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
+
+    // Reads the variable's global slot directly (passes/Resolve.hpp).
+    void bindSlot() { _slotted = true; }
+
+private:
+    bool _slotted;
 };
 
 class StringExp: public ExprNode {
 public:
-    StringExp(std::shared_ptr<Token> token);
+    // Interns the literal (Literals.hpp).
+    StringExp(const Token &token);
+    // Copies the literal into a descriptor of its own, counted like any
+    // string Value's, which the node lets go of when `owner` is rewound.
+    // A streamed program's tree is dropped statement by statement; its
+    // literals go with it rather than piling up in Literals.
+    StringExp(const Token &token, Arena &owner);
     ~StringExp();
 
     virtual void dumpAST(std::string);
     virtual void print();
     // virtual TypeDescriptor evaluate(SymTab &);
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
+
+    // The literal's text, shared by every Value it evaluates to.
+    const StringDescriptor *constant() const { return _constant; }
+
+private:
+    StringExp(const Token &token, const StringDescriptor *owned, Arena &owner);
+
+    const StringDescriptor *_constant;
+};
+
+// True or False, as left by Passes::fold; the token holds 0 or 1 as a
+// whole number.
+class BoolLiteral: public ExprNode {
+public:
+    BoolLiteral(const Token &token);
+    ~BoolLiteral() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 };
 
 class FunctionCall: public ExprNode {
 public:
-    FunctionCall(std::shared_ptr<Token>, std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
+    FunctionCall(const Token &, ArenaPtr<ExprList>);
     ~FunctionCall() = default;
 
     virtual void dumpAST(std::string);
     virtual void print();
-    virtual std::unique_ptr<TypeDescriptor> evaluate(SymTab &);
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
 private:
-    std::string _functionName;
-    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
+    Symbol _functionName;
+    ArenaPtr<ExprList> _testList;
 };
 
 #endif //EXPRINTER_ARITHEXPR_HPP
@@ -4,7 +4,11 @@
 
 #include <string>
 #include <iostream>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
 
+#include "Pool.hpp"
 #include "Token.hpp"
 #include "Debug.hpp"
 
@@ -12,53 +16,184 @@
 class TypeDescriptor {
 
 public:
-    enum types { INTEGER, DOUBLE, BOOL, STRING };
+    // UNDEFINED only marks an empty SymTab slot; no operand is ever one.
+    enum types { INTEGER, DOUBLE, BOOL, STRING, UNDEFINED };
     TypeDescriptor(types type):
         _type{type}
     {}
-    types &type() { return _type; }
-    virtual ~TypeDescriptor() {
-        if (destructor)
-            std::cout << "~TypeDescriptor" << std::endl;
-    }
+    types type() const { return _type; }
 
-private:
+protected:
     types _type;
 };
 
-class NumberDescriptor: public TypeDescriptor {
+// The characters of a string value. Strings are the one type a Value
+// doesn't hold inline; it points at one of these instead, taken from the
+// Pool (as are a StringExp's own), or at one of the constants Literals
+// keeps for string literals.
+// Values holding the same string share one descriptor, kept alive by an
+// intrusive reference count, so copying, reading, comparing and printing
+// a string never copies its characters. They change only through
+// Value::mutableString(), which copies them first unless the Value is
+// the sole owner (copy-on-write).
+//
+// The count is bumped with plain loads and stores: a SymTab and the Values
+// it deals in belong to one thread. A descriptor reachable from Values on
+// more than one thread must be switched to ATOMIC first (Value::share()).
+// CONSTANT descriptors are never counted nor freed.
+class StringDescriptor: public TypeDescriptor {
 
 public:
-    NumberDescriptor(types descType):
-        TypeDescriptor(descType)
+    enum Counting : std::uint8_t { LOCAL, ATOMIC, CONSTANT };
+
+    StringDescriptor(std::string value, Counting counting = LOCAL):
+        TypeDescriptor(STRING),
+        _stringValue{std::move(value)},
+        _refs{1},
+        _counting{counting}
     {}
 
-    ~NumberDescriptor() {
+    ~StringDescriptor() {
         if (destructor)
-            std::cout << "~NumberDescriptor" << std::endl;
+            std::cout << "~StringDescriptor" << std::endl;
     }
 
-    union {
-        int intValue;
-        double doubleValue;
-        int boolValue;
-    } _value;
+    static void *operator new(std::size_t size) { return Pool::allocate(size); }
+    static void operator delete(void *p, std::size_t size) { Pool::release(p, size); }
+
+    void retain() const {
+        if ( _counting == LOCAL )
+            _refs.store(_refs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        else if ( _counting == ATOMIC )
+            _refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Drops a reference; true if it was the last.
+    bool release() const {
+        if ( _counting == LOCAL ) {
+            std::uint32_t refs = _refs.load(std::memory_order_relaxed) - 1;
+            _refs.store(refs, std::memory_order_relaxed);
+            return refs == 0;
+        }
+        if ( _counting == ATOMIC )
+            return _refs.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        return false;
+    }
+
+    // No other Value holds this descriptor, so it may be changed in place.
+    bool unique() const {
+        return _counting == LOCAL && _refs.load(std::memory_order_relaxed) == 1;
+    }
+
+    void shareAcrossThreads() const {
+        if ( _counting == LOCAL )
+            _counting = ATOMIC;
+    }
+
+    std::string _stringValue;
+
+private:
+    mutable std::atomic<std::uint32_t> _refs;
+    mutable Counting _counting;
 };
 
-class StringDescriptor: public TypeDescriptor {
+// What every expression evaluates to and what the SymTab stores: a type
+// and a 64-bit payload, 16 bytes in all, passed and returned by value.
+// Numbers and bools live in the payload, so working with them never
+// allocates; a string's payload is its StringDescriptor, which copies of
+// the Value share and the last one to go frees. A default-constructed
+// Value is UNDEFINED.
+class Value: public TypeDescriptor {
 
 public:
-    StringDescriptor(types descType):
-        TypeDescriptor(descType)
-    {}
+    Value():
+        TypeDescriptor(UNDEFINED)
+    {
+        _value.intValue = 0;
+    }
 
-    ~StringDescriptor() {
-        if (destructor)
-            std::cout << "~StringDescriptor" << std::endl;
+    explicit Value(types type):
+        TypeDescriptor(type)
+    {
+        _value.intValue = 0;
     }
 
-    std::string _stringValue;
+    Value(const Value &other):
+        TypeDescriptor(other._type),
+        _value{other._value}
+    {
+        if ( _type == STRING )
+            _value.stringValue->retain();
+    }
+
+    Value(Value &&other) noexcept:
+        TypeDescriptor(other._type),
+        _value{other._value}
+    {
+        other._type = UNDEFINED;
+    }
+
+    Value &operator=(const Value &other) {
+        if ( this != &other )
+            *this = Value(other);
+        return *this;
+    }
+
+    Value &operator=(Value &&other) noexcept {
+        if ( this != &other ) {
+            release();
+            _type = other._type;
+            _value = other._value;
+            other._type = UNDEFINED;
+        }
+        return *this;
+    }
+
+    ~Value() { release(); }
+
+    bool defined() const { return _type != UNDEFINED; }
+
+    // The characters of a string Value, to be changed in place. If any
+    // other Value shares them (or they are a constant) they are copied
+    // first, into room for at least `capacity` characters.
+    std::string &mutableString(std::size_t capacity = 0) {
+        if ( !_value.stringValue->unique() ) {
+            std::string text;
+            text.reserve(std::max(capacity, _value.stringValue->_stringValue.size()));
+            text += _value.stringValue->_stringValue;
+
+            Value copy(STRING);
+            copy._value.stringValue = new StringDescriptor(std::move(text));
+            *this = std::move(copy);
+        }
+        // Only a descriptor made by a Value (never a constant) is unique.
+        return const_cast<StringDescriptor *>(_value.stringValue)->_stringValue;
+    }
+
+    // Before handing copies of this Value to another thread: the string it
+    // holds, if any, is counted atomically from then on.
+    void share() const {
+        if ( _type == STRING )
+            _value.stringValue->shareAcrossThreads();
+    }
+
+    // All members are 8 bytes wide, so reading intValue off any number
+    // (see negateDescriptor, for `not`) never sees stale bytes.
+    union {
+        std::int64_t intValue;
+        double doubleValue;
+        std::int64_t boolValue;
+        const StringDescriptor *stringValue;
+    } _value;
+
+private:
+    void release() {
+        if ( _type == STRING && _value.stringValue->release() )
+            delete _value.stringValue;
+    }
 };
 
+static_assert(sizeof(Value) == 16, "Value is a type and an 8-byte payload");
+
 
-#endif
\ No newline at end of file
+#endif
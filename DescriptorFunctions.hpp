@@ -1,3 +1,8 @@
+#ifndef __DESCRIPTOR_FUNCTIONS_HPP
+#define __DESCRIPTOR_FUNCTIONS_HPP
+
+#include <cstdio>
+#include <string_view>
 #include "Descriptor.hpp"
 
 // #include <type_traits>
@@ -34,7 +39,7 @@
 
 // template <class T, typename 
 //     std::enable_if<std::__and_<std::is_integral<T>::value, std::is_floating_point<T>::value>::type* = nullptr>
-// inline bool compAll(T lhsVar, T rhsVar, const std::shared_ptr<Token> &t) {
+// inline bool compAll(T lhsVar, T rhsVar, const Token *t) {
 //      if ( t->isRelGT() )
 //         return lhsVar > rhsVar;
 //     else if ( t->isRelLT() )
@@ -60,20 +65,24 @@ namespace Compare {
 
     namespace String {
         // Should use Template /w SFINAE 
-        inline bool compString(std::string lhsVar, std::string rhsVar, const std::shared_ptr<Token> &t) {
+        // Two Values sharing one descriptor pass the same string, which is
+        // equal to itself without reading it.
+        inline bool compString(const std::string &lhsVar, const std::string &rhsVar, const Token *t) {
+
+            int order = &lhsVar == &rhsVar ? 0 : lhsVar.compare(rhsVar);
 
             if ( t->isRelGT() )
-                return lhsVar > rhsVar;
+                return order > 0;
             else if ( t->isRelLT() )
-                return lhsVar < rhsVar;
+                return order < 0;
             else if ( t->isRelGTE() )
-                return lhsVar >= rhsVar;
+                return order >= 0;
             else if ( t->isRelLTE() )
-                return lhsVar <= rhsVar;
+                return order <= 0;
             else if ( t->isRelEQ() )
-                return lhsVar == rhsVar;
+                return order == 0;
             else if ( t->isRelNotEQ() || t->isRelEQML() )
-                return lhsVar != rhsVar;
+                return order != 0;
 
             std::cout << "Condition Not Met -- Comparison::String::compString - no condition for token ";
             t->print();
@@ -84,6 +93,27 @@ namespace Compare {
 
     }
 
+    namespace Number {
+        // Every number is compared as a double (see grabValueFromNumberDescriptor).
+        inline bool compNumber(double lhsVar, double rhsVar, const Token *t) {
+
+            if ( t->isRelGT() )
+                return lhsVar > rhsVar;
+            else if ( t->isRelLT() )
+                return lhsVar < rhsVar;
+            else if ( t->isRelGTE() )
+                return lhsVar >= rhsVar;
+            else if ( t->isRelLTE() )
+                return lhsVar <= rhsVar;
+            else if ( t->isRelEQ() )
+                return lhsVar == rhsVar;
+            else if ( t->isRelNotEQ() || t->isRelEQML() )
+                return lhsVar != rhsVar;
+
+            return false;
+        }
+    }
+
 }
 
 
@@ -92,112 +122,119 @@ namespace Descriptor {
 
      namespace Int {
 
-        inline NumberDescriptor *dieIfNotInt(TypeDescriptor *t) {
+        inline void dieIfNotInt(const Value &t) {
 
-            if ( t->type() != TypeDescriptor::INTEGER ) {
+            if ( t.type() != TypeDescriptor::INTEGER ) {
                 std::cout << "Fatal Error Descriptor::Int::dieIfNotInt" << std::endl;
                 exit(1);
             }
+        }
 
-            auto desc = dynamic_cast<NumberDescriptor *>(t);
+        inline Value createIntDescriptor(std::int64_t value) {
+            Value desc(TypeDescriptor::INTEGER);
+            desc._value.intValue = value;
 
-            if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotInt" << std::endl;
-                exit(1);
-            }
-
-            return desc;
+            return desc; 
         }
 
-        inline std::unique_ptr<TypeDescriptor> createIntDescriptor(int value) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::INTEGER);
-            desc->_value.intValue = value;
+        inline void incrementByN(std::int64_t n, Value &t) {
 
-            return desc; 
+            dieIfNotInt(t);
+            t._value.intValue += n;
         }
 
-        inline void incrementByN(int n, TypeDescriptor *t) {
+        inline std::int64_t getIntValue(const Value &t) {
 
-            auto desc = dieIfNotInt(t);
-            desc->_value.intValue += n;
+            dieIfNotInt(t);
+            return t._value.intValue;
         }
 
-        inline int getIntValue(TypeDescriptor *t) {
+        inline void flipSignBit(Value &t) {
 
-            auto desc = dieIfNotInt(t);
-            return desc->_value.intValue;
+            dieIfNotInt(t);
+            t._value.intValue *= -1;
         }
 
-        inline void flipSignBit(TypeDescriptor *t) {
+        // INTEGER op INTEGER, once both operands are known to be integers.
+        inline Value arithmetic(std::int64_t lhsVar, std::int64_t rhsVar, const Token *t) {
+
+            if( t->isAdditionOperator() )
+                return createIntDescriptor(lhsVar + rhsVar);
+            else if(t->isSubtractionOperator())
+                return createIntDescriptor(lhsVar - rhsVar);
+            else if(t->isMultiplicationOperator())
+                return createIntDescriptor(lhsVar * rhsVar);
+            else if(t->isDivisionOperator()) {
+                if ( rhsVar == 0 ) {
+                    std::cout << "Warning: Division by zero is undefined" << std::endl;
+                    exit(1);
+                }
+                return createIntDescriptor(lhsVar / rhsVar); // division by zero?
+            }
+            else if( t->isModuloOperator() )
+                return createIntDescriptor(lhsVar % rhsVar);
 
-            auto desc = dieIfNotInt(t);
-            desc->_value.intValue *= -1;
+            std::cout << "ERRRRRR" << std::endl;
+            exit(1);
+            return Value();
         }
     };
 
     namespace Bool {
 
-        inline NumberDescriptor *dieIfNotBool(TypeDescriptor *t) {
+        inline void dieIfNotBool(const Value &t) {
 
-            if ( t->type() != TypeDescriptor::BOOL ) {
+            if ( t.type() != TypeDescriptor::BOOL ) {
                 std::cout << "Fatal Error Descriptor::Int::dieIfNotBool" << std::endl;
                 exit(1);
             }
-
-            auto desc = dynamic_cast<NumberDescriptor *>(t);
-
-            if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
-                exit(1);
-            }
-
-            return desc;
         }
 
-        inline std::unique_ptr<TypeDescriptor> createBooleanDescriptor(bool value) {
+        inline Value createBooleanDescriptor(bool value) {
 
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::BOOL);
-            desc->_value.boolValue = (int) value;
+            Value desc(TypeDescriptor::BOOL);
+            desc._value.boolValue = (int) value;
             return desc;
         }
 
-        inline bool getBoolValue(TypeDescriptor *t) {
+        inline bool getBoolValue(const Value &t) {
 
-            auto desc = dieIfNotBool(t);
-            return (bool) desc->_value.boolValue;
+            dieIfNotBool(t);
+            return (bool) t._value.boolValue;
         }
 
     };
 
     namespace String {
 
-        inline StringDescriptor *dieIfNotString(TypeDescriptor *t) {
+        inline void dieIfNotString(const Value &t) {
 
-            if ( t->type() != TypeDescriptor::STRING ) {
+            if ( t.type() != TypeDescriptor::STRING ) {
                 std::cout << "Fatal Error Descriptor::Int::dieIfNotString" << std::endl;
                 exit(1);
             }
+        }
 
-            auto desc = dynamic_cast<StringDescriptor *>(t);
-
-            if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotBool" << std::endl;
-                exit(1);
-            }
-
+        inline Value createStringDescriptor(std::string value) {
+            Value desc(TypeDescriptor::STRING);
+            desc._value.stringValue = new StringDescriptor(std::move(value));
             return desc;
         }
 
-        inline std::unique_ptr<TypeDescriptor> createStringDescriptor(std::string value) {
-            auto desc = std::make_unique<StringDescriptor>(TypeDescriptor::STRING);
-            desc->_stringValue = value;
+        // Shares a StringExp's descriptor; nothing is copied. (Counting a
+        // Literals constant costs nothing.)
+        inline Value createStringConstant(const StringDescriptor *constant) {
+            Value desc(TypeDescriptor::STRING);
+            constant->retain();
+            desc._value.stringValue = constant;
             return desc;
         }
 
-        inline std::string getStringValue(TypeDescriptor *t) {
+        // Shared with every other Value holding the string; copy it to keep it.
+        inline const std::string &getStringValue(const Value &t) {
 
-            auto desc = dieIfNotString(t);
-            return desc->_stringValue;
+            dieIfNotString(t);
+            return t._value.stringValue->_stringValue;
 
         }
 
@@ -205,109 +242,72 @@ namespace Descriptor {
 
     namespace Double {
 
-        inline NumberDescriptor *dieIfNotDouble(TypeDescriptor *t) {
-
-            if ( t->type() != TypeDescriptor::DOUBLE ) {
-                std::cout << "Fatal Error Descriptor::Double::dieIfNotDouble.." << t->type() << std::endl;
-                exit(1);
-            }
-
-            auto desc = dynamic_cast<NumberDescriptor *>(t);
+        inline void dieIfNotDouble(const Value &t) {
 
-            if ( desc == nullptr ) {
-                std::cout << "Fatal Error .. Dynamic Cast Failed dieIfNotDouble" << std::endl;
+            if ( t.type() != TypeDescriptor::DOUBLE ) {
+                std::cout << "Fatal Error Descriptor::Double::dieIfNotDouble.." << t.type() << std::endl;
                 exit(1);
             }
-
-            return desc;
-
         }
 
-        inline double getDoubleValue(TypeDescriptor *t) {
-            auto desc = dieIfNotDouble(t);
-            return desc->_value.doubleValue;
+        inline double getDoubleValue(const Value &t) {
+            dieIfNotDouble(t);
+            return t._value.doubleValue;
         }
 
-        inline std::unique_ptr<TypeDescriptor> createDoubleDescriptor(double value) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::DOUBLE);
-            desc->_value.doubleValue = value;
+        inline Value createDoubleDescriptor(double value) {
+            Value desc(TypeDescriptor::DOUBLE);
+            desc._value.doubleValue = value;
             return desc;
         }
 
-        inline void flipSignBit(TypeDescriptor *t) {
+        inline void flipSignBit(Value &t) {
 
-            auto desc = dieIfNotDouble(t);
-            desc->_value.doubleValue *= -1;
+            dieIfNotDouble(t);
+            t._value.doubleValue *= -1;
         }
     };
 
 
 
-    inline void printValue(TypeDescriptor *desc) {
-        
-        NumberDescriptor *nDesc = dynamic_cast<NumberDescriptor *>(desc);
-
-        if ( nDesc != nullptr ) {
-            if( nDesc->type() == TypeDescriptor::INTEGER ) 
-                std::cout << nDesc->_value.intValue;
-            else if( nDesc->type() == TypeDescriptor::DOUBLE )
-                std::cout << nDesc->_value.doubleValue;
-            else if( nDesc->type() == TypeDescriptor::BOOL ) 
-                std::cout << nDesc->_value.boolValue;
-            else
-                std::cout << "Misconfigured union type." << std::endl;
-
-            return;
-        }
-
-        else {
-            StringDescriptor *sDesc = dynamic_cast<StringDescriptor *>(desc);
-
-            if ( sDesc != nullptr ) {
-                std::cout << sDesc->_stringValue;
-            }
-        }
+    // Same text as Python 2's str(float): 12 significant digits, and a
+    // trailing ".0" on whole values.
+    inline void printDouble(double value) {
+        char buf[32];
+        int n = snprintf(buf, sizeof(buf), "%.12g", value);
+        std::cout << buf;
+        if ( std::string_view(buf, n).find_first_of(".eni") == std::string_view::npos )
+            std::cout << ".0";
     }
 
-    inline std::unique_ptr<TypeDescriptor> copyReferencePtr(TypeDescriptor *ref) {
-        
-        if (ref->type() == TypeDescriptor::INTEGER) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::INTEGER);
-            desc->_value.intValue = dynamic_cast<NumberDescriptor *>(ref)->_value.intValue; //risky
+    inline void printValue(const Value &desc) {
 
-            return desc;
-
-        } else if (ref->type() == TypeDescriptor::DOUBLE) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::DOUBLE);
-            desc->_value.doubleValue = dynamic_cast<NumberDescriptor *>(ref)->_value.doubleValue;
-
-            return desc;
-
-        } else if (ref->type() == TypeDescriptor::BOOL) {
-            auto desc = std::make_unique<NumberDescriptor>(TypeDescriptor::BOOL);
-            desc->_value.boolValue = dynamic_cast<NumberDescriptor *>(ref)->_value.boolValue;
+        if( desc.type() == TypeDescriptor::INTEGER ) 
+            std::cout << desc._value.intValue;
+        else if( desc.type() == TypeDescriptor::DOUBLE )
+            printDouble(desc._value.doubleValue);
+        else if( desc.type() == TypeDescriptor::BOOL ) 
+            std::cout << desc._value.boolValue;
+        else if( desc.type() == TypeDescriptor::STRING )
+            std::cout << desc._value.stringValue->_stringValue;
+    }
 
-            return desc;
+    // For operands whose type Passes::inferTypes has proven (see
+    // ExprNode::staticType), so no check is needed.
+    namespace Unchecked {
 
-        } else if (ref->type() == TypeDescriptor::STRING) {
-            auto desc = std::make_unique<StringDescriptor>(TypeDescriptor::STRING);
-            desc->_stringValue = dynamic_cast<StringDescriptor *>(ref)->_stringValue;
- 
-            return desc;
+        inline bool isNumber(int type) {
+            return type == TypeDescriptor::INTEGER || type == TypeDescriptor::DOUBLE || type == TypeDescriptor::BOOL;
+        }
 
-        } else {
-            std::cout << "ERROR" << std::endl;
-            exit(1);
-            // Silence Warnings
-            return nullptr;
+        // How `and` and `or` take a number: true when it is above zero. A
+        // double is compared as a double, not by its bits.
+        inline bool positive(const Value &t) {
+            return t.type() == TypeDescriptor::DOUBLE ? t._value.doubleValue > 0 : t._value.intValue > 0;
         }
     }
 
-    
-    inline bool validTypeOp(TypeDescriptor *t1, TypeDescriptor *t2) {
-
-        auto lhsType = t1->type();
-        auto rhsType = t2->type();
+    constexpr bool validTypeOp(int lhsType, int rhsType) {
 
         if ( lhsType == rhsType )
             return true;
@@ -320,180 +320,33 @@ namespace Descriptor {
         else return false;
     }
 
-    inline std::unique_ptr<TypeDescriptor> negateDescriptor(TypeDescriptor *t) {
-
-        if (t->type() != TypeDescriptor::BOOL) {
-
-            if ( t->type() == TypeDescriptor::DOUBLE || t->type() == TypeDescriptor::INTEGER ) {
-                auto ptr = dynamic_cast<NumberDescriptor *>(t);
-                return Bool::createBooleanDescriptor( ptr->_value.intValue == 0 ? true : false );
-            }
-            return Bool::createBooleanDescriptor(false);
-        }
-
-        auto casted = dynamic_cast<NumberDescriptor *>(t);
-        return Bool::createBooleanDescriptor( !casted->_value.boolValue );
-    }
-
-    inline std::unique_ptr<TypeDescriptor> andDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs) {
-        
-        if ( (lhs->type() == TypeDescriptor::BOOL || lhs->type() == TypeDescriptor::INTEGER || lhs->type() == TypeDescriptor::DOUBLE) && 
-             (rhs->type() == TypeDescriptor::BOOL || rhs->type() == TypeDescriptor::INTEGER || rhs->type() == TypeDescriptor::DOUBLE) ) {
-
-            auto lhsPtr = dynamic_cast<NumberDescriptor *>(lhs);
-            auto rhsPtr = dynamic_cast<NumberDescriptor *>(rhs);
-
-            // Don't care if its int double -- we just want to see bits.
-            int lhsValue = lhsPtr->_value.intValue;
-            int rhsValue = rhsPtr->_value.intValue;
-
-
-            return (( lhsValue > 0 && rhsValue > 0)/* || ( lhsValue < 0 && rhsValue < 0 ) || ( lhsValue == rhsValue )*/)
-                ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        } else {
-            std::cout << "andDescriptor bad types - quitting" << std::endl;
-            exit(1);
-            return nullptr;
-        }
+    inline bool validTypeOp(const Value &t1, const Value &t2) {
+        return validTypeOp(t1.type(), t2.type());
     }
 
-    inline std::unique_ptr<TypeDescriptor> orDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs) {
-        //Same as and - offset load 2 function later
-        if ( (lhs->type() == TypeDescriptor::BOOL || lhs->type() == TypeDescriptor::INTEGER || lhs->type() == TypeDescriptor::DOUBLE) && 
-             (rhs->type() == TypeDescriptor::BOOL || rhs->type() == TypeDescriptor::INTEGER || rhs->type() == TypeDescriptor::DOUBLE) ) {
+    inline Value negateDescriptor(const Value &t) {
 
-            auto lhsPtr = dynamic_cast<NumberDescriptor *>(lhs);
-            auto rhsPtr = dynamic_cast<NumberDescriptor *>(rhs);
+        if (t.type() != TypeDescriptor::BOOL) {
 
-            // Don't care if its int double -- we just want to see bits.
-            int lhsValue = lhsPtr->_value.intValue;
-            int rhsValue = rhsPtr->_value.intValue;
-
-            return ( lhsValue > 0 || rhsValue > 0 ) ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        } else {
-            std::cout << "andDescriptor bad types - quitting" << std::endl;
-            exit(1);
-            return nullptr;
+            if ( t.type() == TypeDescriptor::DOUBLE || t.type() == TypeDescriptor::INTEGER )
+                return Bool::createBooleanDescriptor( t._value.intValue == 0 ? true : false );
+            return Bool::createBooleanDescriptor(false);
         }
 
+        return Bool::createBooleanDescriptor( !t._value.boolValue );
     }
 
-    inline void grabValueFromNumberDescriptor(double &fill, NumberDescriptor *ptr) {
+    inline void grabValueFromNumberDescriptor(double &fill, const Value &ptr) {
 
-        if (ptr->type() == TypeDescriptor::INTEGER) {
-            fill = (float) ptr->_value.intValue;
-        } else if (ptr->type() == TypeDescriptor::DOUBLE) {
-            fill = ptr->_value.doubleValue;
-        } else if (ptr->type() == TypeDescriptor::BOOL) {
+        if (ptr.type() == TypeDescriptor::INTEGER) {
+            fill = (double) ptr._value.intValue;
+        } else if (ptr.type() == TypeDescriptor::DOUBLE) {
+            fill = ptr._value.doubleValue;
+        } else if (ptr.type() == TypeDescriptor::BOOL) {
             fill = 1.; 
         }
     }
-
-    inline std::unique_ptr<TypeDescriptor> relOperatorDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs, const std::shared_ptr<Token> &t) {
-        
-        // Check for string concat
-        if ( lhs->type() == TypeDescriptor::STRING && rhs->type() == TypeDescriptor::STRING && t->isAdditionOperator() ) {
-
-            auto lhsPtr = dynamic_cast<StringDescriptor *>(lhs);
-            auto rhsPtr = dynamic_cast<StringDescriptor *>(rhs);
-
-            if ( lhsPtr == nullptr || rhsPtr == nullptr ) {
-                std::cout << "Descriptor::relOperatorDescriptor - Error casting to string descriptor" << std::endl;
-                exit(1);
-            }
-
-            return String::createStringDescriptor(lhsPtr->_stringValue + rhsPtr->_stringValue);
-        }
-
-        if ( lhs->type() == TypeDescriptor::DOUBLE && rhs->type() == TypeDescriptor::DOUBLE ) {
-            return Double::createDoubleDescriptor(Double::getDoubleValue(lhs) + Double::getDoubleValue(rhs));
-        }
-
-        // Only support on integers from now on!
-        if ( lhs->type() != TypeDescriptor::INTEGER || rhs->type() != TypeDescriptor::INTEGER ) {
-
-            std::cout << "Unsupported Type Returning Garbage Value 1" << std::endl;
-
-            return Int::createIntDescriptor(1);
-        }
-
-        auto lhsPtr = dynamic_cast<NumberDescriptor*>(lhs);
-        auto rhsPtr = dynamic_cast<NumberDescriptor*>(rhs);
-
-        int lhsVar = lhsPtr->_value.intValue;
-        int rhsVar = rhsPtr->_value.intValue; 
-
-        if( t->isAdditionOperator() )
-            return Int::createIntDescriptor(lhsVar + rhsVar);
-        else if(t->isSubtractionOperator())
-            return Int::createIntDescriptor(lhsVar - rhsVar);
-        else if(t->isMultiplicationOperator())
-            return Int::createIntDescriptor(lhsVar * rhsVar);
-        else if(t->isDivisionOperator()) {
-            if ( rhsVar == 0 ) {
-                std::cout << "Warning: Division by zero is undefined" << std::endl;
-                exit(1);
-            }
-            return Int::createIntDescriptor(lhsVar / rhsVar); // division by zero?
-        }
-        else if( t->isModuloOperator() ) {
-            if ( lhsPtr->type() != TypeDescriptor::INTEGER || rhs->type() != TypeDescriptor::INTEGER ) {
-                std::cout << "Error: invalid operands to binary expression NOTINT and NOTINT" << std::endl;
-                exit(1);
-            }
-            return Int::createIntDescriptor(lhsVar % rhsVar);
-        }
-        else {
-            std::cout << "ERRRRRR" << std::endl;
-            exit(1);
-            return nullptr;
-        }
-    }
-
-    inline std::unique_ptr<TypeDescriptor> comparisonDescriptor(TypeDescriptor *lhs, TypeDescriptor *rhs, const std::shared_ptr<Token> &t) {
-
-        if ( lhs->type() == TypeDescriptor::STRING && rhs->type() == TypeDescriptor::STRING ) {
-
-            std::string lhsVar = String::getStringValue(lhs);
-            std::string rhsVar = String::getStringValue(rhs);
-
-            return Compare::String::compString(lhsVar, rhsVar, t) 
-                ?  Bool::createBooleanDescriptor(true)
-                :  Bool::createBooleanDescriptor(false);
-
-        }
-
-        // // We don't support comparisonOp on strings yet
-        // if (lhs->type() == TypeDescriptor::STRING || rhs->type() == TypeDescriptor::STRING) {
-        //     std::cout << "Unsupported operator on type -> returning garbage value" << std::endl;
-        //     return Bool::createBooleanDescriptor(true);
-        // }
-
-        auto lhsPtr = dynamic_cast<NumberDescriptor*>(lhs);
-        auto rhsPtr = dynamic_cast<NumberDescriptor*>(rhs);
-
-        double lhsVar;
-        grabValueFromNumberDescriptor(lhsVar, lhsPtr);
-
-        double rhsVar; 
-        grabValueFromNumberDescriptor(rhsVar, rhsPtr);
-   
-        if ( t->isRelGT() )
-            return lhsVar > rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false); 
-        else if ( t->isRelLT() )
-            return lhsVar < rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        else if ( t->isRelGTE() )
-            return lhsVar >= rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        else if ( t->isRelLTE() )
-            return lhsVar <= rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        else if ( t->isRelEQ() )
-            return lhsVar == rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-        else if ( t->isRelNotEQ() || t->isRelEQML() )
-            return lhsVar != rhsVar ? Bool::createBooleanDescriptor(true) : Bool::createBooleanDescriptor(false);
-
-        return nullptr;
-    }
 };
 
 
-// #endif
\ No newline at end of file
+#endif
@@ -0,0 +1,170 @@
+#include <functional>
+
+#include "Dispatch.hpp"
+#include "DescriptorFunctions.hpp"
+
+namespace Descriptor {
+
+    namespace {
+
+        // Only the Op is looked at: FlatTree hands over tokens of no kind.
+        const char *scopeOf(const Token *op) {
+            switch ( op->op() ) {
+                case Token::REL_GT: case Token::REL_LT: case Token::REL_GTE:
+                case Token::REL_LTE: case Token::REL_EQ: case Token::REL_NOT_EQ: case Token::REL_EQML:
+                    return "ComparisonExprNode::evaluate()";
+                case Token::AND: case Token::OR:
+                    return "BooleanExprNode::evaluate()";
+                default:
+                    return "InfixExprNode::evaluate()";
+            }
+        }
+
+        Value incompatible(const Value &lhs, const Value &rhs, const Token *op) {
+            std::cout << scopeOf(op) << "-Fatal Error - Operands / Operators not compatible" << std::endl;
+            std::cout << "Operator Enum { INTEGER = 0, DOUBLE = 1, BOOL = 2, STRING = 3 }" << std::endl;
+            std::cout << "LHS Operator: " << lhs.type() << "\t RHS Operator: " << rhs.type() << std::endl;
+            exit(1);
+            return Value();
+        }
+
+        Value unknownOperator(const Value &, const Value &, const Token *) {
+            std::cout << "ERRRRRR" << std::endl;
+            exit(1);
+            return Value();
+        }
+
+        // ARITHMETIC START
+        Value garbage(const Value &, const Value &, const Token *) {
+            std::cout << "Unsupported Type Returning Garbage Value 1" << std::endl;
+            return Int::createIntDescriptor(1);
+        }
+
+        Value intAdd(const Value &lhs, const Value &rhs, const Token *) {
+            return Int::createIntDescriptor(lhs._value.intValue + rhs._value.intValue);
+        }
+
+        Value intSubtract(const Value &lhs, const Value &rhs, const Token *) {
+            return Int::createIntDescriptor(lhs._value.intValue - rhs._value.intValue);
+        }
+
+        Value intMultiply(const Value &lhs, const Value &rhs, const Token *) {
+            return Int::createIntDescriptor(lhs._value.intValue * rhs._value.intValue);
+        }
+
+        Value intDivide(const Value &lhs, const Value &rhs, const Token *) {
+            if ( rhs._value.intValue == 0 ) {
+                std::cout << "Warning: Division by zero is undefined" << std::endl;
+                exit(1);
+            }
+            return Int::createIntDescriptor(lhs._value.intValue / rhs._value.intValue);
+        }
+
+        Value intModulo(const Value &lhs, const Value &rhs, const Token *) {
+            return Int::createIntDescriptor(lhs._value.intValue % rhs._value.intValue);
+        }
+
+        // Whatever the operator.
+        Value doubleAdd(const Value &lhs, const Value &rhs, const Token *) {
+            return Double::createDoubleDescriptor(lhs._value.doubleValue + rhs._value.doubleValue);
+        }
+
+        Value concatenate(const Value &lhs, const Value &rhs, const Token *) {
+            return String::createStringDescriptor(lhs._value.stringValue->_stringValue + rhs._value.stringValue->_stringValue);
+        }
+        // ARITHMETIC END
+
+        // COMPARISON START
+        template <class Compare>
+        Value compareNumbers(const Value &lhs, const Value &rhs, const Token *) {
+            double lhsVar, rhsVar;
+            grabValueFromNumberDescriptor(lhsVar, lhs);
+            grabValueFromNumberDescriptor(rhsVar, rhs);
+            return Bool::createBooleanDescriptor(Compare()(lhsVar, rhsVar));
+        }
+
+        // Values sharing a descriptor are equal without reading it.
+        template <class Compare>
+        Value compareStrings(const Value &lhs, const Value &rhs, const Token *) {
+            const StringDescriptor *l = lhs._value.stringValue, *r = rhs._value.stringValue;
+            int order = l == r ? 0 : l->_stringValue.compare(r->_stringValue);
+            return Bool::createBooleanDescriptor(Compare()(order, 0));
+        }
+        // COMPARISON END
+
+        // BOOLEAN START
+        Value numberAnd(const Value &lhs, const Value &rhs, const Token *) {
+            return Bool::createBooleanDescriptor(Unchecked::positive(lhs) && Unchecked::positive(rhs));
+        }
+
+        Value numberOr(const Value &lhs, const Value &rhs, const Token *) {
+            return Bool::createBooleanDescriptor(Unchecked::positive(lhs) || Unchecked::positive(rhs));
+        }
+
+        Value badBooleanTypes(const Value &, const Value &, const Token *) {
+            std::cout << "andDescriptor bad types - quitting" << std::endl;
+            exit(1);
+            return Value();
+        }
+        // BOOLEAN END
+
+        template <template <class> class Compare>
+        constexpr Kernel comparison(bool strings) {
+            return strings ? compareStrings<Compare<int>> : compareNumbers<Compare<double>>;
+        }
+
+        constexpr Kernel arithmetic(int lhs, int rhs, Token::Op op) {
+            if ( lhs == TypeDescriptor::INTEGER && rhs == TypeDescriptor::INTEGER ) {
+                switch ( op ) {
+                    case Token::ADD:      return intAdd;
+                    case Token::SUBTRACT: return intSubtract;
+                    case Token::MULTIPLY: return intMultiply;
+                    case Token::DIVIDE:   return intDivide;
+                    default:              return intModulo;
+                }
+            }
+            if ( lhs == TypeDescriptor::DOUBLE && rhs == TypeDescriptor::DOUBLE )
+                return doubleAdd;
+            if ( lhs == TypeDescriptor::STRING && rhs == TypeDescriptor::STRING && op == Token::ADD )
+                return concatenate;
+            return garbage;
+        }
+
+        constexpr Kernel kernel(int lhs, int rhs, Token::Op op) {
+            bool strings = lhs == TypeDescriptor::STRING && rhs == TypeDescriptor::STRING;
+
+            switch ( op ) {
+                case Token::ADD: case Token::SUBTRACT: case Token::MULTIPLY:
+                case Token::DIVIDE: case Token::MODULO:
+                    return validTypeOp(lhs, rhs) ? arithmetic(lhs, rhs, op) : incompatible;
+
+                case Token::REL_GT:     return validTypeOp(lhs, rhs) ? comparison<std::greater>(strings)       : incompatible;
+                case Token::REL_LT:     return validTypeOp(lhs, rhs) ? comparison<std::less>(strings)          : incompatible;
+                case Token::REL_GTE:    return validTypeOp(lhs, rhs) ? comparison<std::greater_equal>(strings) : incompatible;
+                case Token::REL_LTE:    return validTypeOp(lhs, rhs) ? comparison<std::less_equal>(strings)    : incompatible;
+                case Token::REL_EQ:     return validTypeOp(lhs, rhs) ? comparison<std::equal_to>(strings)      : incompatible;
+                case Token::REL_NOT_EQ:
+                case Token::REL_EQML:   return validTypeOp(lhs, rhs) ? comparison<std::not_equal_to>(strings)  : incompatible;
+
+                case Token::AND:
+                    return !validTypeOp(lhs, rhs) ? incompatible : strings ? badBooleanTypes : numberAnd;
+                case Token::OR:
+                    return !validTypeOp(lhs, rhs) ? incompatible : strings ? badBooleanTypes : numberOr;
+
+                default:
+                    return unknownOperator;
+            }
+        }
+
+        constexpr KernelTable buildKernels() {
+            KernelTable table{};
+            for (int lhs = 0; lhs < kernelTypes; lhs++)
+                for (int rhs = 0; rhs < kernelTypes; rhs++)
+                    for (int op = 0; op < kernelOps; op++)
+                        table.kernels[lhs][rhs][op] = kernel(lhs, rhs, static_cast<Token::Op>(op));
+            return table;
+        }
+    };
+
+    constexpr KernelTable binaryKernels = buildKernels();
+};
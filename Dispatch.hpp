@@ -0,0 +1,39 @@
+#ifndef __DISPATCH_HPP
+#define __DISPATCH_HPP
+
+#include "Descriptor.hpp"
+#include "Token.hpp"
+
+namespace Descriptor {
+
+    // One binary operation on operands of known types: arithmetic, a
+    // comparison, and or or. The operator is passed along for the kernels
+    // that serve several (a comparison's message, string +).
+    using Kernel = Value (*)(const Value &lhs, const Value &rhs, const Token *op);
+
+    // A kernel for every (lhs type, rhs type, operator), built at compile
+    // time. Entries for operands that can't be combined print the
+    // "Operands / Operators not compatible" error and exit; the rest give
+    // the same results, warnings and errors the operators always have,
+    // quirks included (double op double adds, mixed numbers give a garbage
+    // 1, a bool compares as 1.0).
+    const int kernelTypes = TypeDescriptor::STRING + 1;
+    const int kernelOps = Token::WHILE + 1;
+
+    struct KernelTable {
+        Kernel kernels[kernelTypes][kernelTypes][kernelOps];
+    };
+
+    extern const KernelTable binaryKernels;
+
+    inline Kernel kernelFor(int lhsType, int rhsType, Token::Op op) {
+        return binaryKernels.kernels[lhsType][rhsType][op];
+    }
+
+    // `lhs op rhs`, dispatched on the operands' type tags.
+    inline Value binary(const Value &lhs, const Value &rhs, const Token *op) {
+        return kernelFor(lhs.type(), rhs.type(), op->op())(lhs, rhs, op);
+    }
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include <iostream>
+
+#include "FlatExpr.hpp"
+#include "DescriptorFunctions.hpp"
+#include "Dispatch.hpp"
+
+namespace {
+
+    // The kernels read the operator off a Token; the flat layout only
+    // keeps the Op, so hand them one of these.
+    const Token *opToken(Token::Op op) {
+        static const struct Table {
+            Token tokens[Token::WHILE + 1];
+            Table() {
+                for (int op = 0; op <= Token::WHILE; op++)
+                    tokens[op] = Token(Token::SYMBOL, static_cast<Token::Op>(op));
+            }
+        } table;
+        return &table.tokens[op];
+    }
+}
+
+FlatTree::Index FlatTree::append(Kind kind, Token::Op op, Index left, Index right) {
+    _kind.push_back(kind);
+    _op.push_back(op);
+    _left.push_back(left);
+    _right.push_back(right);
+    _payload.push_back(Payload{0});
+    return static_cast<Index>(_kind.size() - 1);
+}
+
+FlatTree::Index FlatTree::flatten(ExprNode *node) {
+
+    const Token *tok = node->token();
+
+    if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+        Index left = flatten(infix->_left.get());
+        if ( infix->_right == nullptr )
+            return append(NEGATE, tok->op(), left, 0);
+        Index right = flatten(infix->_right.get());
+        return append(INFIX, tok->op(), left, right);
+    }
+
+    if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) ) {
+        Index left = flatten(comparison->_left.get());
+        Index right = flatten(comparison->_right.get());
+        return append(COMPARISON, tok->op(), left, right);
+    }
+
+    if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) ) {
+        Index left = flatten(boolean->_left.get());
+        if ( tok->isNot() )
+            return append(NOT, tok->op(), left, 0);
+        Index right = flatten(boolean->_right.get());
+        return append(tok->isAnd() ? AND : OR, tok->op(), left, right);
+    }
+
+    Index i;
+    if ( dynamic_cast<WholeNumber *>(node) ) {
+        i = append(WHOLE_NUMBER, Token::NO_OP, 0, 0);
+        _payload[i].wholeNumber = tok->getWholeNumber();
+    } else if ( dynamic_cast<Double *>(node) ) {
+        i = append(DOUBLE, Token::NO_OP, 0, 0);
+        _payload[i].floatValue = tok->getFloat();
+    } else if ( dynamic_cast<BoolLiteral *>(node) ) {
+        i = append(BOOL, Token::NO_OP, 0, 0);
+        _payload[i].wholeNumber = tok->getWholeNumber();
+    } else if ( dynamic_cast<Variable *>(node) ) {
+        i = append(VARIABLE, Token::NO_OP, 0, 0);
+        _payload[i].symbol = tok->getSymbol();
+    } else if ( auto string = dynamic_cast<StringExp *>(node) ) {
+        i = append(STRING, Token::NO_OP, 0, 0);
+        _payload[i].string = string->constant();
+    } else {
+        i = append(OPAQUE, Token::NO_OP, 0, 0);
+        _payload[i].opaque = node;
+    }
+    return i;
+}
+
+void FlatTree::truncate(std::size_t size) {
+    _kind.resize(size);
+    _op.resize(size);
+    _left.resize(size);
+    _right.resize(size);
+    _payload.resize(size);
+}
+
+Value FlatTree::evaluate(Index i, SymTab &symTab) const {
+
+    switch ( _kind[i] ) {
+
+        case WHOLE_NUMBER:
+            return Descriptor::Int::createIntDescriptor( _payload[i].wholeNumber );
+
+        case DOUBLE:
+            return Descriptor::Double::createDoubleDescriptor( _payload[i].floatValue );
+
+        case BOOL:
+            return Descriptor::Bool::createBooleanDescriptor( _payload[i].wholeNumber != 0 );
+
+        case STRING:
+            return Descriptor::String::createStringConstant( _payload[i].string );
+
+        case VARIABLE: {
+            Symbol symbol = _payload[i].symbol;
+            if ( !symTab.isDefined(symbol) ) {
+                std::cout << "Variable::evaluate - Fatal Error - Bypassing Debug\n";
+                std::cout << "Use of undefined variable, " << Symbols::name(symbol) << std::endl;
+                exit(1);
+            }
+            return *symTab.getValueFor(symbol);
+        }
+
+        case NEGATE: {
+            auto lValue = evaluate(_left[i], symTab);
+
+            if (lValue.type() == TypeDescriptor::INTEGER) {
+                Descriptor::Int::flipSignBit(lValue);
+            } else if (lValue.type() == TypeDescriptor::DOUBLE) {
+                Descriptor::Double::flipSignBit(lValue);
+            } else {
+                std::cout << "InfixExprNode::evaluate - Error - Invalid Subtraction operator on type " << lValue.type() << std::endl;
+                exit(1);
+            }
+            return lValue;
+        }
+
+        case INFIX:
+        case COMPARISON:
+        case AND:
+        case OR: {
+            auto lValue = evaluate(_left[i], symTab);
+            auto rValue = evaluate(_right[i], symTab);
+            return Descriptor::binary(lValue, rValue, opToken(_op[i]));
+        }
+
+        case NOT: {
+            auto result = evaluate(_left[i], symTab);
+            return Descriptor::negateDescriptor(result);
+        }
+
+        case OPAQUE:
+            return _payload[i].opaque->evaluate(symTab);
+    }
+
+    std::cout << "FlatTree::evaluate BAD KIND" << std::endl;
+    exit(1);
+    return Value();
+}
+
+// FlatExprNode START
+FlatExprNode::FlatExprNode(const FlatTree &tree, FlatTree::Index root, ExprNode *original):
+    ExprNode{*original->token()},
+    _tree{tree},
+    _root{root},
+    _original{original}
+{}
+
+void FlatExprNode::dumpAST(std::string space) {
+    _original->dumpAST(space);
+}
+
+void FlatExprNode::print() {
+    _original->print();
+}
+
+Value FlatExprNode::evaluate(SymTab &symTab) {
+    return _tree.evaluate(_root, symTab);
+}
+
+void FlatExprNode::serialize(ProgramWriter &out) {
+    _original->serialize(out);
+}
+// FlatExprNode END
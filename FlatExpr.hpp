@@ -0,0 +1,86 @@
+#ifndef __FLAT_EXPR_HPP
+#define __FLAT_EXPR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "ArithExpr.hpp"
+#include "SymTab.hpp"
+#include "Token.hpp"
+#include "Descriptor.hpp"
+
+// An alternative layout for expressions. Every node of every flattened
+// expression in a program is stored in one FlatTree, as parallel arrays
+// (struct of arrays) of kind, operator, child links and payload. Children
+// are linked by 32-bit index, and each subtree is laid out children first,
+// so evaluating it walks the arrays mostly forward.
+class FlatTree {
+
+public:
+    using Index = std::uint32_t;
+
+    enum Kind : std::uint8_t {
+        INFIX,          // left op right
+        NEGATE,         // unary minus on left
+        COMPARISON,
+        AND,
+        OR,
+        NOT,            // on left
+        WHOLE_NUMBER,
+        DOUBLE,
+        BOOL,
+        VARIABLE,
+        STRING,
+        OPAQUE          // an ExprNode with no flat form (FunctionCall)
+    };
+
+    // Appends `node` and its subtree; returns the index of its root.
+    Index flatten(ExprNode *node);
+
+    // Same results, and the same errors, as node->evaluate().
+    Value evaluate(Index root, SymTab &symTab) const;
+
+    std::size_t size() const { return _kind.size(); }
+
+    // Drops every node appended since size() was `size`.
+    void truncate(std::size_t size);
+
+private:
+    Index append(Kind kind, Token::Op op, Index left, Index right);
+
+    union Payload {
+        std::int64_t wholeNumber;
+        double floatValue;
+        Symbol symbol;
+        const StringDescriptor *string;     // a StringExp's descriptor
+        ExprNode *opaque;
+    };
+
+    std::vector<Kind> _kind;
+    std::vector<Token::Op> _op;
+    std::vector<Index> _left;
+    std::vector<Index> _right;
+    std::vector<Payload> _payload;
+};
+
+// Stands in for an expression tree once it has been flattened. The original
+// nodes stay in the Arena, for dumpAST and print.
+class FlatExprNode: public ExprNode {
+public:
+    FlatExprNode(const FlatTree &tree, FlatTree::Index root, ExprNode *original);
+    ~FlatExprNode() = default;
+
+    virtual void dumpAST(std::string);
+    virtual void print();
+    virtual Value evaluate(SymTab &);
+    virtual void serialize(ProgramWriter &);
+
+private:
+    const FlatTree &_tree;
+    FlatTree::Index _root;
+    ExprNode *_original;
+};
+
+#endif
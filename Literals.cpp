@@ -0,0 +1,57 @@
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Literals.hpp"
+
+namespace {
+
+    // A deque never moves its elements, so the descriptors Values point
+    // at, and the views the index holds into their text, stay valid.
+    std::deque<StringDescriptor> &constants() {
+        static std::deque<StringDescriptor> constants;
+        return constants;
+    }
+
+    std::unordered_map<std::string_view, const StringDescriptor *> &index() {
+        static std::unordered_map<std::string_view, const StringDescriptor *> index;
+        return index;
+    }
+
+    std::mutex &lock() {
+        static std::mutex lock;
+        return lock;
+    }
+}
+
+namespace Literals {
+
+    const StringDescriptor *intern(std::string_view text) {
+
+        // As in Symbols::intern, the shared table is only locked for a
+        // literal's first use on a thread. Nothing shared is read outside
+        // the lock: the thread's own map holds what it was handed under
+        // it, and a constant is never changed once it has been published.
+        thread_local std::unordered_map<std::string_view, const StringDescriptor *> seen;
+
+        auto known = seen.find(text);
+        if (known != seen.end())
+            return known->second;
+
+        std::lock_guard<std::mutex> guard(lock());
+
+        const StringDescriptor *constant;
+        auto found = index().find(text);
+        if (found != index().end()) {
+            constant = found->second;
+        } else {
+            constants().emplace_back(std::string(text), StringDescriptor::CONSTANT);
+            constant = &constants().back();
+            index().emplace(constant->_stringValue, constant);
+        }
+
+        seen.emplace(constant->_stringValue, constant);
+        return constant;
+    }
+};
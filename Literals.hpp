@@ -0,0 +1,28 @@
+#ifndef __LITERALS_HPP
+#define __LITERALS_HPP
+
+#include <string_view>
+
+#include "Descriptor.hpp"
+
+// Every string literal in a program read whole, interned as it is parsed.
+// Each distinct text gets one immutable, constant StringDescriptor that
+// lives as long as the process, so a StringExp evaluates to a Value
+// sharing it instead of copying its characters: copying or dropping a
+// Value that holds a constant touches neither the heap nor the Pool.
+// Equal literals anywhere in the program share one descriptor.
+//
+// A piped program's literals are not interned: its tree only lives for a
+// statement, and so do they (see StringExp).
+//
+// Numbers need nothing of the kind: a Token carries its value already
+// converted and a Value holds it inline.
+//
+// intern() may be called from several threads at once (ParallelParser's
+// workers do).
+namespace Literals {
+
+    const StringDescriptor *intern(std::string_view text);
+};
+
+#endif
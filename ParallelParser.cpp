@@ -0,0 +1,135 @@
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "ParallelParser.hpp"
+#include "Parser.hpp"
+#include "lex/Scan.hpp"
+#include "lex/TokenStream.hpp"
+
+namespace {
+
+    // Whether a line starting at `p` is at column 0 and can only begin a new
+    // top-level statement. Blank and comment lines don't change indentation
+    // and so may sit inside a block; elif and else continue the if above.
+    bool startsStatement(const char *p, const char *end) {
+
+        if ( isspace(*p) || *p == '#' )
+            return false;
+
+        for (const char *keyword : { "elif", "else" }) {
+            std::size_t n = std::strlen(keyword);
+            if ( static_cast<std::size_t>(end - p) >= n && std::memcmp(p, keyword, n) == 0 &&
+                 ( p + n == end || !( isalnum(p[n]) || p[n] == '_' ) ) )
+                return false;
+        }
+        return true;
+    }
+};
+
+ParallelParser::Chunk::Chunk(Source &source, const char *begin, const char *end, std::uint32_t line):
+    lexer(source, begin, end, line)
+{}
+
+ParallelParser::ParallelParser(Source &source, unsigned threads, std::size_t chunkSize):
+    _source{source},
+    _threads{threads > 0 ? threads : 1}
+{
+    std::size_t perThread = source.size() / (4 * _threads);
+    split(perThread > chunkSize ? perThread : chunkSize);
+}
+
+// Walks the source the way the Lexer would, but only as far as telling
+// strings and comments apart from code: a newline inside a string literal
+// (escaped, continuing it) doesn't end the line but, as in the Lexer,
+// still counts towards the line number.
+void ParallelParser::split(std::size_t chunkSize) {
+
+    const char *begin = _source.begin();
+    const char *end = _source.end();
+
+    const char *chunkStart = begin;
+    std::uint32_t chunkLine = 1;
+    std::uint32_t line = 1;
+
+    for (const char *p = begin; p < end; ) {
+
+        if ( static_cast<std::size_t>(p - chunkStart) >= chunkSize && startsStatement(p, end) ) {
+            _chunks.push_back(std::make_unique<Chunk>(_source, chunkStart, p, chunkLine));
+            chunkStart = p;
+            chunkLine = line;
+        }
+
+        while ( p < end && *p != '\n' ) {
+            char c = *p++;
+            if ( c == '#' ) {
+                p = Scan::findNewline(p, end);
+                break;
+            }
+            if ( c == '"' || c == '\'' ) {
+                while ( p < end && *p != c ) {
+                    if ( *p == '\\' )
+                        p++;
+                    if ( p < end && *p == '\n' )
+                        line++;
+                    p++;
+                }
+                if ( p < end )
+                    p++;
+            }
+        }
+
+        if ( p < end ) {
+            p++;
+            line++;
+        }
+    }
+
+    _chunks.push_back(std::make_unique<Chunk>(_source, chunkStart, end, chunkLine));
+}
+
+ArenaPtr<Statements> ParallelParser::file_input(Arena &arena) {
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+
+    auto work = [this, &next, &failed] {
+        Lexer::abandonOnError = true;
+
+        for (std::size_t i = next++; i < _chunks.size() && !failed; i = next++) {
+            Chunk &chunk = *_chunks[i];
+            try {
+                TokenStream tokens(chunk.lexer, true);
+                Parser parser(tokens, chunk.arena);
+                chunk.stmts = parser.file_input();
+            } catch (ParseAbandoned &) {
+                failed = true;
+            }
+        }
+
+        Lexer::abandonOnError = false;
+    };
+
+    // The calling thread is one of the pool.
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < _threads && t < _chunks.size(); t++)
+        pool.emplace_back(work);
+    work();
+    for (auto &&thread : pool)
+        thread.join();
+
+    if ( failed )
+        return nullptr;
+
+    std::size_t total = 0;
+    for (auto &&chunk : _chunks)
+        total += chunk->stmts->_statements.size();
+
+    ArenaPtr<Statements> stmts = arena.make<Statements>(arena);
+    stmts->_statements.reserve(total);
+    for (auto &&chunk : _chunks)
+        for (auto &&s : chunk->stmts->_statements)
+            stmts->_statements.push_back(std::move(s));
+
+    return stmts;
+}
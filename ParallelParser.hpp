@@ -0,0 +1,61 @@
+#ifndef __PARALLEL_PARSER_HPP
+#define __PARALLEL_PARSER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Arena.hpp"
+#include "lex/Lexer.hpp"
+#include "lex/Source.hpp"
+#include "statements/Statement.hpp"
+
+// Parses a large program on several threads. A pre-scan splits the source
+// into chunks at lines that can only start a new top-level statement (text
+// at column 0 that is not a comment, an elif or an else, and not inside a
+// string literal). Each chunk gets its own Lexer, Parser and Arena, and the
+// chunks are handed out to a pool of threads. Their statements are then
+// concatenated in order, which gives the same tree as Parser::file_input()
+// on the whole text: every top-level statement lies within one chunk, and
+// each chunk's Lexer starts on the line number the serial one would be on.
+//
+// Workers never report a syntax error themselves (see
+// Lexer::abandonOnError); file_input() just returns nullptr, and the caller
+// parses serially to report it exactly as it always has.
+class ParallelParser {
+
+public:
+    // Smaller programs are not worth the threads.
+    static const std::size_t minimumSize = 1024 * 1024;
+
+    // `source` must not be streaming, and must outlive this ParallelParser.
+    // Chunks are at least `chunkSize` bytes, and there are about four per
+    // thread so that the pool stays busy when their costs differ.
+    ParallelParser(Source &source, unsigned threads, std::size_t chunkSize = 256 * 1024);
+
+    // The whole program, or nullptr if it has a syntax error. The top-level
+    // Statements is placed in `arena`; everything under it lives in the
+    // chunks' arenas (and their Lexers' string pools), which last as long as
+    // this ParallelParser.
+    ArenaPtr<Statements> file_input(Arena &arena);
+
+    std::size_t chunks() const { return _chunks.size(); }
+
+private:
+    struct Chunk {
+        Chunk(Source &source, const char *begin, const char *end, std::uint32_t line);
+
+        Lexer lexer;
+        Arena arena;
+        ArenaPtr<Statements> stmts;
+    };
+
+    void split(std::size_t chunkSize);
+
+    Source &_source;
+    unsigned _threads;
+    std::vector<std::unique_ptr<Chunk>> _chunks;
+};
+
+#endif
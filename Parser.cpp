@@ -3,41 +3,122 @@
 
 #include "Parser.hpp"
 
-Parser::Parser(Lexer &lex):
-    lexer{lex}
+namespace {
+
+    // How tightly an operator binds, loosest first.
+    enum Precedence : std::uint8_t {
+        OR_PRECEDENCE = 1,
+        AND_PRECEDENCE,
+        NOT_PRECEDENCE,
+        COMPARISON_PRECEDENCE,
+        SUM_PRECEDENCE,
+        PRODUCT_PRECEDENCE,
+        UNARY_PRECEDENCE
+    };
+
+    enum NodeKind : std::uint8_t {
+        NO_NODE, INFIX_NODE, COMPARISON_NODE, BOOLEAN_NODE
+    };
+
+    struct Binding {
+        std::uint8_t precedence;
+        bool rightAssociative;
+        NodeKind node;
+    };
+
+    // Every expression operator, indexed by Token::Op. A new operator only
+    // needs an entry here (and a token from the Lexer).
+    struct OperatorTable {
+        Binding infix[Token::WHILE + 1];
+        Binding prefix[Token::WHILE + 1];
+
+        OperatorTable(): infix{}, prefix{} {
+            infix[Token::OR]         = { OR_PRECEDENCE,         false, BOOLEAN_NODE    };
+            infix[Token::AND]        = { AND_PRECEDENCE,        false, BOOLEAN_NODE    };
+
+            infix[Token::REL_GT]     = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_LT]     = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_GTE]    = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_LTE]    = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_EQ]     = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_NOT_EQ] = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+            infix[Token::REL_EQML]   = { COMPARISON_PRECEDENCE, false, COMPARISON_NODE };
+
+            infix[Token::ADD]        = { SUM_PRECEDENCE,        false, INFIX_NODE      };
+            infix[Token::SUBTRACT]   = { SUM_PRECEDENCE,        false, INFIX_NODE      };
+
+            infix[Token::MULTIPLY]   = { PRODUCT_PRECEDENCE,    false, INFIX_NODE      };
+            infix[Token::DIVIDE]     = { PRODUCT_PRECEDENCE,    false, INFIX_NODE      };
+            infix[Token::MODULO]     = { PRODUCT_PRECEDENCE,    false, INFIX_NODE      };
+
+            prefix[Token::NOT]       = { NOT_PRECEDENCE,        false, BOOLEAN_NODE    };
+            prefix[Token::SUBTRACT]  = { UNARY_PRECEDENCE,      false, INFIX_NODE      };
+        }
+    };
+
+    const OperatorTable operators;
+
+    template <class Node>
+    ArenaPtr<ExprNode> joined(Arena &arena, const Token &tok, ArenaPtr<ExprNode> left, ArenaPtr<ExprNode> right) {
+        ArenaPtr<Node> p = arena.make<Node>(tok);
+        p->_left = std::move(left);
+        p->_right = std::move(right);
+        return p;
+    }
+}
+
+Parser::Parser(TokenStream &tokenStream, Arena &nodeArena):
+    tokens{tokenStream},
+    arena{nodeArena}
 {}
  
-void Parser::die(std::string where, std::string message, std::shared_ptr<Token> token) {
+void Parser::die(std::string where, std::string message, const Token &token) {
+    if (Lexer::abandonOnError)
+        throw ParseAbandoned{};
+
     std::cout << where << " " << message << std::endl;
-    token->print();
+    token.print();
     std::cout << std::endl;
-    std::cout << "\nThe following is a list of tokens that have been identified up to this point.\n";
-    lexer.printProcessedTokens();
+
+    const Span &span = token.span();
+    std::cout << "\n" << tokens.source().name() << ":" << span.line << ":" << span.column << ":\n";
+    std::cout << tokens.source().lineAt(span.offset) << "\n";
+    std::cout << std::string(span.column > 0 ? span.column - 1 : 0, ' ')
+              << std::string(span.length > 0 ? span.length : 1, '^') << std::endl;
+
+    std::cout << "\nThe following are the last tokens identified up to this point.\n";
+    tokens.printRecentTokens(16);
     exit(1);
 } 
 
-std::unique_ptr<Statements> Parser::file_input() {
+ArenaPtr<Statements> Parser::file_input() {
 
     std::string scope = "Parser::file_input()";
 
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();
-    std::unique_ptr<Statements> stmts = std::make_unique<Statements>();
+    ArenaPtr<Statements> stmts = arena.make<Statements>(arena);
 
-    while ( !tok->eof() ) {
-        lexer.ungetToken();
-        stmts->addStatement(stmt());
+    while ( auto statement = next_stmt() )
+        stmts->addStatement(std::move(statement));
 
-        tok = lexer.getToken();
-    }
-    
     return stmts;
 }
 
+ArenaPtr<Statement> Parser::next_stmt() {
 
-std::unique_ptr<Statement> Parser::stmt() {
+    // Nothing before a top-level statement is ever looked at again.
+    tokens.release();
+
+    if ( tokens.peek().eof() )
+        return nullptr;
+
+    return stmt();
+}
+
+
+ArenaPtr<Statement> Parser::stmt() {
     // stmt -> simple_stmt | compound_stmt
 
     std::string scope = "Parser::stmt()";
@@ -45,21 +126,21 @@ std::unique_ptr<Statement> Parser::stmt() {
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( tok->isFunc() || tok->isFor() || tok->isIf() ) {
+    if ( tok.isFunc() || tok.isFor() || tok.isIf() ) {
 
-        lexer.ungetToken();
+        tokens.ungetToken();
         return compound_stmt();
 
     } else {
-        lexer.ungetToken();
+        tokens.ungetToken();
         return simple_stmt();
     }
 }
 
 
-std::unique_ptr<Statement> Parser::simple_stmt() {
+ArenaPtr<Statement> Parser::simple_stmt() {
     // Parse grammar rule 
     // <simple_stmt> -> { print_stmt | assign_stmt | call_stmt | return_stmt } NEWLINE
     // We haven't done -> arrayop
@@ -68,47 +149,47 @@ std::unique_ptr<Statement> Parser::simple_stmt() {
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
 
-    if ( !(tok->isPrint() || tok->isName() || tok->isReturn()) ) {
+    if ( !(tok.isPrint() || tok.isName() || tok.isReturn()) ) {
         die(scope, "violating rule", tok);
     }
 
-    if (  tok->isPrint() ) {
-        lexer.ungetToken();
-        std::unique_ptr<PrintStatement> printStmt = print_stmt();
+    if (  tok.isPrint() ) {
+        tokens.ungetToken();
+        ArenaPtr<PrintStatement> printStmt = print_stmt();
         getEOL(scope);
         return printStmt;
 
     }
-    else if ( tok->isReturn() ) {
+    else if ( tok.isReturn() ) {
         // std::unique_ptr<ReturnStatement> retStmt = return_stmt();
         // getEOF(scope);
         // return retStmt;
     }
-    else if ( tok->isName() ) {
+    else if ( tok.isName() ) {
 
         auto cachedToken = tok;
 
-        tok = lexer.getToken();
-        if ( tok->isAssignmentOperator() ) {
-            lexer.ungetToken();
-            std::unique_ptr<AssignStmt> assignStmt = assign_stmt(cachedToken);
+        tok = tokens.getToken();
+        if ( tok.isAssignmentOperator() ) {
+            tokens.ungetToken();
+            ArenaPtr<AssignStmt> assignStmt = assign_stmt(cachedToken);
             getEOL(scope);
             return assignStmt;
         } 
-        else if (tok->isOpenParen()) {
-            lexer.ungetToken();
-            std::unique_ptr<FunctionCallStatement> callStmt = 
-                std::make_unique<FunctionCallStatement> (
+        else if (tok.isOpenParen()) {
+            tokens.ungetToken();
+            ArenaPtr<FunctionCallStatement> callStmt = 
+                arena.make<FunctionCallStatement>(
                     call(cachedToken)
                 );
             getEOL(scope);
             return callStmt;
         } else {
             die(scope, "Unidentified -> 1 <-", tok);
-        } // Remember to add else if(tok->isPerioid()) // array operator
+        } // Remember to add else if(tok.isPerioid()) // array operator
 
     } else {
         die(scope, "Unidentified -> 1 <-", tok);
@@ -120,67 +201,67 @@ std::unique_ptr<Statement> Parser::simple_stmt() {
 }
 
 void Parser::getEOL(std::string scope) {
-    auto tok = lexer.getToken();
-    if ( !tok->eol() )
+    auto tok = tokens.getToken();
+    if ( !tok.eol() )
         die(scope, "Generic getEOL", tok);
 }
 
 
-std::unique_ptr<PrintStatement> Parser::print_stmt() {
+ArenaPtr<PrintStatement> Parser::print_stmt() {
 
     std::string scope = "Parser::print_stmt()";
 
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( !tok->isPrint() )
+    if ( !tok.isPrint() )
         die(scope, "Expected `PRINT` keyword, instead got", tok);
 
     auto testList = testlist();
 
-    return std::make_unique<PrintStatement>(std::move(testList));
+    return arena.make<PrintStatement>(std::move(testList));
 
 }
 
-std::unique_ptr<AssignStmt> Parser::assign_stmt(std::shared_ptr<Token> varName) {
+ArenaPtr<AssignStmt> Parser::assign_stmt(const Token &varName) {
 
     std::string scope = "Parser::assign_stmt";
     
     if (debug)
         std::cout << scope << std::endl;
 
-    auto assignOp = lexer.getToken();
-    if ( !assignOp->isAssignmentOperator() )
+    auto assignOp = tokens.getToken();
+    if ( !assignOp.isAssignmentOperator() )
         die(scope, "Parser::assign_stmt() expected `ASSIGN_OP` instead got ", assignOp);
 
-    std::unique_ptr<ExprNode> rightHandSideExpr = test();
+    ArenaPtr<ExprNode> rightHandSideExpr = test();
 
     if (debug)
         std::cout << scope << " return" << std::endl;
 
 
-    return std::make_unique<AssignStmt>(varName->getName(), std::move(rightHandSideExpr));
+    return arena.make<AssignStmt>(varName.getSymbol(), std::move(rightHandSideExpr));
 }
 
-std::unique_ptr<Statement> Parser::compound_stmt() {
+ArenaPtr<Statement> Parser::compound_stmt() {
 
     std::string scope = "Parser::compound_stmt";
 
     if (debug)
         std::cout << scope << std::endl;
     
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( tok->isFor() ) {
-        lexer.ungetToken();
+    if ( tok.isFor() ) {
+        tokens.ungetToken();
         return for_stmt();
-    } else if ( tok->isIf() ) {
-        lexer.ungetToken();
+    } else if ( tok.isIf() ) {
+        tokens.ungetToken();
         return if_stmt();
-    } else if ( tok->isFunc() ) {
-        lexer.ungetToken();
+    } else if ( tok.isFunc() ) {
+        tokens.ungetToken();
         return func_def();
     }
 
@@ -190,7 +271,7 @@ std::unique_ptr<Statement> Parser::compound_stmt() {
 }
 
 
-std::unique_ptr<IfStatement> Parser::if_stmt() {
+ArenaPtr<IfStatement> Parser::if_stmt() {
 
     // Parses the grammar rule 
 
@@ -201,77 +282,77 @@ std::unique_ptr<IfStatement> Parser::if_stmt() {
     if (debug)
         std::cout << scope << std::endl;
 
-    auto ifStatement = std::make_unique<IfStatement>();
-    auto tok = lexer.getToken();
+    auto ifStatement = arena.make<IfStatement>();
+    auto tok = tokens.getToken();
 
-    if (! tok->isIf()) {
+    if (! tok.isIf()) {
         die(scope, "Expected `if` keyword, instead got", tok);
     }
 
     // ExprNode *comp = test();
-    std::unique_ptr<ExprNode> comp = test();
+    ArenaPtr<ExprNode> comp = test();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isColon() ) {
+    if ( !tok.isColon() ) {
         die(scope, "Expected `:` keyword, instead got", tok);
     }
 
     // std::unique_ptr<GroupedStatements> stmts = suite();
-    std::unique_ptr<Statements> stmts = suite();
+    ArenaPtr<Statements> stmts = suite();
 
-    auto ifStmt = std::make_unique<IfStmt>(std::move(comp), std::move(stmts));
+    auto ifStmt = arena.make<IfStmt>(std::move(comp), std::move(stmts));
     ifStatement->addIfStmt(std::move(ifStmt));
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
     bool conditionHit = false;
 
-    if (tok->isElIf()) {
+    if (tok.isElIf()) {
 
         conditionHit = true;
-        auto elseIfStatements = std::make_unique<ElifStmt>();
+        auto elseIfStatements = arena.make<ElifStmt>(arena);
 
-        while (tok ->isElIf()) {
+        while (tok.isElIf()) {
 
-            std::unique_ptr<ExprNode> elifCmp = test();
+            ArenaPtr<ExprNode> elifCmp = test();
 
-            tok = lexer.getToken();
-            if ( !tok->isColon() ) {
+            tok = tokens.getToken();
+            if ( !tok.isColon() ) {
                 die(scope, "Expected `:` keyword, instead got", tok);
             }
 
             // std::unique_ptr<GroupedStatements> stmts = suite();
-            std::unique_ptr<Statements> stmts = suite();
+            ArenaPtr<Statements> stmts = suite();
 
             elseIfStatements->addStatement(std::move(elifCmp), std::move(stmts));
 
-            tok = lexer.getToken();
+            tok = tokens.getToken();
             conditionHit = false;
         }
 
     //need this unget token for if / elif no else
-        // lexer.ungetToken();
+        // tokens.ungetToken();
 
         ifStatement->addElifStmt(std::move(elseIfStatements));
     }
 
-    if (tok->isElse()) {
+    if (tok.isElse()) {
         // std::cout << "Is else" << std::endl;
         conditionHit = true;
-        tok = lexer.getToken();
-        if ( !tok->isColon() )
+        tok = tokens.getToken();
+        if ( !tok.isColon() )
             die(scope, "Expected `:` keyword, instead got", tok);
 
         // std::unique_ptr<GroupedStatements> stmts = suite();
         // std::unique_ptr<Statements> stmts = suite();
         // auto elseStmt = std::make_unique<ElseStmt>(std::move(stmts));
-        auto elseStmt = std::make_unique<ElseStmt>(suite());
+        auto elseStmt = arena.make<ElseStmt>(suite());
 
         ifStatement->addElseStmt(std::move(elseStmt));
     }
 
     if ( !conditionHit )
-        lexer.ungetToken();
+        tokens.ungetToken();
 
 
     if (debug)
@@ -280,64 +361,64 @@ std::unique_ptr<IfStatement> Parser::if_stmt() {
     return ifStatement;
 }
 
-std::unique_ptr<RangeStmt> Parser::for_stmt() {
+ArenaPtr<RangeStmt> Parser::for_stmt() {
 
     std::string scope = "Parser::for_stmt";
 
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if (! tok->isFor() )
+    if (! tok.isFor() )
         die(scope, "Expected `FOR` _keyword, instead got", tok);
 
     // GET ID
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( ! tok->isName() )
+    if ( ! tok.isName() )
         die(scope, "Expected `NAME` _keyword, instead got", tok);
 
-    std::string varName = tok->getName();
+    Symbol varName = tok.getSymbol();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if (! tok->isIn() )
+    if (! tok.isIn() )
         die(scope, "Expected `IN` _keyword, instead got", tok);
 
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isRange() )
+    if ( !tok.isRange() )
         die(scope, "Expected `RANGE`, instead got", tok);
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
 
-    if ( !tok->isOpenParen() )
+    if ( !tok.isOpenParen() )
         die(scope, "Expected `OPENPAREN`, instead got", tok);
 
 
     auto list = testlist();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isCloseParen() ) {
+    if ( !tok.isCloseParen() ) {
         die(scope, "Expected `CLOSEPAREN`, instead got", tok);
     }
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isColon() )
+    if ( !tok.isColon() )
         die(scope, "Expected `:` symbol, instead got", tok);
 
     // std::unique_ptr<GroupedStatements> stmts = suite();
-    std::unique_ptr<Statements> stmts = suite();
+    ArenaPtr<Statements> stmts = suite();
 
     if (debug)
         std::cout << scope << " return" << std::endl;
 
-    std::unique_ptr<RangeStmt> range = std::make_unique<RangeStmt>(varName);
+    ArenaPtr<RangeStmt> range = arena.make<RangeStmt>(varName);
     // range->parseTestList(list);
     range->addTestList(std::move(list));
     range->addStatements(std::move(stmts));
@@ -345,100 +426,100 @@ std::unique_ptr<RangeStmt> Parser::for_stmt() {
     return range;
 }
 
-std::unique_ptr<Statement> Parser::func_def() {
+ArenaPtr<Statement> Parser::func_def() {
     // func_def: 'def' ID '(' [parameter_list] ')' ':' suite
     // Should be func_suite instead of suite
     std::string scope = "Parser::func_def()";
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( !tok->isFunc() ) 
+    if ( !tok.isFunc() ) 
         die(scope, "Expected `def` instead got", tok);
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isName() )
+    if ( !tok.isName() )
         die(scope, "Expected `<ID>` instead got", tok);
 
-    std::string funcName = tok->getName();
+    Symbol funcName = tok.getSymbol();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isOpenParen() )
+    if ( !tok.isOpenParen() )
         die(scope, "Expected `(` instead got", tok);
 
-    std::vector<std::string> parameterList = parameter_list();
+    ArenaVector<Symbol> parameterList = parameter_list();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isCloseParen() )
+    if ( !tok.isCloseParen() )
         die(scope, "Expected `)` instead got", tok);
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isColon() )
+    if ( !tok.isColon() )
         die(scope, "Expected `:` instead got", tok);
 
-    std::unique_ptr<Statements> 
+    ArenaPtr<Statements> 
         FIX_AND_WRITE_FUNC_SUITE_THIS_IS_NOT_FUNC_SUITE = suite();
 
-    return std::make_unique<FunctionDefinition>(funcName, parameterList, std::move(FIX_AND_WRITE_FUNC_SUITE_THIS_IS_NOT_FUNC_SUITE), false);
+    return arena.make<FunctionDefinition>(funcName, parameterList, std::move(FIX_AND_WRITE_FUNC_SUITE_THIS_IS_NOT_FUNC_SUITE), false);
 }
 
-std::vector<std::string> Parser::parameter_list() {
+ArenaVector<Symbol> Parser::parameter_list() {
     // parameter_list: ID {, ID }*
     std::string scope = "Parser::parameter_list()";
 
-    std::vector<std::string> argNames;
-    auto tok = lexer.getToken();
+    ArenaVector<Symbol> argNames(arena);
+    auto tok = tokens.getToken();
 
-    while ( tok->isName() ) {
+    while ( tok.isName() ) {
 
-        if ( tok->isComma() )
-            tok = lexer.getToken();
+        if ( tok.isComma() )
+            tok = tokens.getToken();
 
-        if ( !tok->isName() )
+        if ( !tok.isName() )
             die(scope, "Expected `<ID>` got", tok);
 
-        argNames.push_back( tok->getName() );
+        argNames.push_back( tok.getSymbol() );
 
-        tok = lexer.getToken();
+        tok = tokens.getToken();
 
-        if ( tok->isComma() )
-            tok = lexer.getToken();
+        if ( tok.isComma() )
+            tok = tokens.getToken();
     }
 
-    lexer.ungetToken();
+    tokens.ungetToken();
     return argNames;
 }
 
 
-std::unique_ptr<Statements> Parser::suite() {
+ArenaPtr<Statements> Parser::suite() {
     //Parses the grammar rule 
     // <suite> -> EOL INDENT stmt+ DEDENT
     std::string scope = "Parser::suite";
-    std::unique_ptr<Statements> stmts = std::make_unique<Statements>();
+    ArenaPtr<Statements> stmts = arena.make<Statements>(arena);
 
     if (debug)
         std::cout << scope << std::endl;
 
-    auto tok = lexer.getToken();  // Expect an EOL
-    if ( !tok->eol() )
+    auto tok = tokens.getToken();  // Expect an EOL
+    if ( !tok.eol() )
         die(scope, "Expected an `EOL`, instead got", tok);
 
-    tok = lexer.getToken();      // Expect an INDENT
-    if ( !tok->isIndent() )
+    tok = tokens.getToken();      // Expect an INDENT
+    if ( !tok.isIndent() )
         die(scope, "Expected an `INDENT`, instead got", tok);
 
-    tok = lexer.getToken();
-    while ( !tok->isDedent() ) {
-        lexer.ungetToken();
+    tok = tokens.getToken();
+    while ( !tok.isDedent() ) {
+        tokens.ungetToken();
         stmts->addStatement(stmt());
-        tok = lexer.getToken();
+        tok = tokens.getToken();
 
     }
 
-    if ( tok->isDedent() )
+    if ( tok.isDedent() )
         return stmts;
 
 
@@ -447,271 +528,137 @@ std::unique_ptr<Statements> Parser::suite() {
 }
 
 
-std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> Parser::testlist() {
+ArenaPtr<ExprList> Parser::testlist() {
 
     std::string scope = "Parser::testlist()"; 
 
-    auto p = std::make_unique<std::vector<std::unique_ptr<ExprNode>>>();
+    auto p = arena.make<ExprList>(arena);
 
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( tok->isCloseParen() ) {
-        lexer.ungetToken();
+    if ( tok.isCloseParen() ) {
+        tokens.ungetToken();
         return p;
     }
 
-    lexer.ungetToken();
+    tokens.ungetToken();
     p->push_back(test());
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    while ( tok->isComma() ) {
+    while ( tok.isComma() ) {
         p->push_back(test());
-        tok = lexer.getToken();
+        tok = tokens.getToken();
     }
 
-    lexer.ungetToken();
+    tokens.ungetToken();
     return p;
 }
 
-std::unique_ptr<ExprNode> Parser::test() {
-
-    std::string scope = "*Parser::test()";
+ArenaPtr<ExprNode> Parser::test() {
 
     if (debug)
-        std::cout << scope << std::endl;
+        std::cout << "*Parser::test()" << std::endl;
 
-    return or_test();
+    return binary_expr(OR_PRECEDENCE);
 }
 
-std::unique_ptr<ExprNode> Parser::or_test() {
+ArenaPtr<ExprNode> Parser::binary_expr(int minPrecedence) {
+    // Precedence climbing over operators.infix. This function parses:
 
-    std::string scope = "*Parser::or_test()";
+    // <binary_expr(p)> -> <unary_expr(p)> { <op> <binary_expr(q)> }*
 
-    if (debug)
-        std::cout << scope << std::endl;
+    // for every <op> that binds at least as tightly as p, where q is the
+    // precedence of <op>, plus one if <op> is left-associative.
 
-    std::unique_ptr<ExprNode> left = and_test();
-    auto tok = lexer.getToken();
+    ArenaPtr<ExprNode> left = unary_expr(minPrecedence);
 
-    while ( tok->isOr() ) {
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = std::move(left); 
-        p->_right = and_test();
-        left = std::move(p);
-        tok = lexer.getToken();
-    }
+    while ( true ) {
+        const Binding &op = operators.infix[tokens.peek().op()];
 
-    lexer.ungetToken();
+        if ( op.node == NO_NODE || op.precedence < minPrecedence )
+            break;
 
-    if (debug)
-        std::cout << scope << " return" << std::endl;
+        Token tok = tokens.getToken();
+        ArenaPtr<ExprNode> right = binary_expr(op.rightAssociative ? op.precedence : op.precedence + 1);
 
-    return left;
-}
-
-std::unique_ptr<ExprNode> Parser::and_test() {
-    std::string scope = "*Parser::and_test()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    std::unique_ptr<ExprNode> left = not_test();
-    auto tok = lexer.getToken();
-
-    while ( tok->isAnd() ) {
-
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = not_test();
-        left = std::move(p);
-        tok = lexer.getToken();
+        switch ( op.node ) {
+            case INFIX_NODE:
+                left = joined<InfixExprNode>(arena, tok, std::move(left), std::move(right));
+                break;
+            case COMPARISON_NODE:
+                left = joined<ComparisonExprNode>(arena, tok, std::move(left), std::move(right));
+                break;
+            default:
+                left = joined<BooleanExprNode>(arena, tok, std::move(left), std::move(right));
+                break;
+        }
     }
-    lexer.ungetToken();
-
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
 
     return left;
 }
 
-std::unique_ptr<ExprNode> Parser::not_test() {
-
-    std::string scope = "*Parser::not_test()";
-
-    if (debug)
-        std::cout << scope << std::endl;   
-
-    auto tok = lexer.getToken();
-
-    if ( tok->isNot() ) {
-        std::unique_ptr<BooleanExprNode> p = std::make_unique<BooleanExprNode>(tok);
-        p->_left = not_test();
-        return p;
-
-    } else {
-        lexer.ungetToken();
-        return comparison();
-    }
-}
-
-std::unique_ptr<ExprNode> Parser::comparison() {
-    // This function parses the grammar rule:
-
-    // <comparison> -> <arith_expr> { <comp_op> <arith_expr> }*
-
-    std::string scope = "*Parser::comparison()";
+ArenaPtr<ExprNode> Parser::unary_expr(int minPrecedence) {
+    // This function parses the grammar rules:
 
-    if (debug)
-        std::cout << scope << std::endl;
+    // <unary_expr(p)> -> <prefix_op> <binary_expr(q)> | <primary>
 
-    std::unique_ptr<ExprNode> left = arith_expr();
-    auto tok = lexer.getToken();
-    
-    while (tok->isCompOp()) {
-        std::unique_ptr<ComparisonExprNode> p = std::make_unique<ComparisonExprNode>(tok);
+    // for a <prefix_op> that binds at least as tightly as p, where q is
+    // its precedence. A unary operator keeps its operand in _left.
 
-        p->_left = std::move(left);
-        p->_right = arith_expr();
-        left = std::move(p);
-        tok = lexer.getToken();
-    }
+    const Binding &op = operators.prefix[tokens.peek().op()];
 
-    lexer.ungetToken();
+    if ( op.node == NO_NODE || op.precedence < minPrecedence )
+        return primary();
 
-    if (debug)
-        std::cout << scope << " return" << std::endl;
+    Token tok = tokens.getToken();
+    ArenaPtr<ExprNode> operand = binary_expr(op.precedence);
 
-    return left;
+    if ( op.node == INFIX_NODE )
+        return joined<InfixExprNode>(arena, tok, std::move(operand), nullptr);
+    return joined<BooleanExprNode>(arena, tok, std::move(operand), nullptr);
 }
 
-std::unique_ptr<ExprNode> Parser::arith_expr() {
+ArenaPtr<ExprNode> Parser::primary() {
     // This function parses the grammar rules:
 
-    // <arith_expr> -> <term> { ( + | - ) <term> }
-    std::string scope = "*Parser::arith_expr()";
+    // <primary> -> <id> '(' <testlist> ')' | <atom>
 
     if (debug)
-        std::cout << scope << std::endl;
+        std::cout << "*Parser::primary()" << std::endl;
 
-    std::unique_ptr<ExprNode> left = term();
-    auto tok = lexer.getToken();
+    auto left = atom();
 
-    while (tok->isAdditionOperator() || tok->isSubtractionOperator()) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = term();
-        left = std::move(p);
-        tok = lexer.getToken();
+    if ( left->token()->isName() && tokens.peek().isOpenParen() ) {
+        //function
+        return call( *left->token() );
     }
-    lexer.ungetToken();
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
 
     return left;
 }
 
-//TODO -> add support for -> // <- op in tokenizer
-std::unique_ptr<ExprNode> Parser::term() {
-    // This function parses the grammar rules:
-
-    // <term> -> <factor> { ( * | / | % | // ) <factor> }*
-    std::string scope = "ExprNode *Parser::term()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-    
-    std::unique_ptr<ExprNode> left = factor();
-    
-    auto tok = lexer.getToken();
-    
-    while ( tok->isMultiplicationOperator() || tok->isDivisionOperator() || tok->isModuloOperator() ) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = std::move(left);
-        p->_right = factor();
-        left = std::move(p);
-        tok = lexer.getToken();
-    }
-    lexer.ungetToken();
-
-    if (debug)
-        std::cout << scope << " return" << std::endl;
-
-    return left;
-}
-
-std::unique_ptr<ExprNode> Parser::call(std::shared_ptr<Token> ID) {
+ArenaPtr<ExprNode> Parser::call(const Token &ID) {
 
     std::string scope = "Parser::call()";
-    auto tok = lexer.getToken();
+    auto tok = tokens.getToken();
 
-    if ( !tok->isOpenParen() ) {
+    if ( !tok.isOpenParen() ) {
         die(scope, "Expected `(`", tok);
     }
 
-    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> tlist = testlist();
+    ArenaPtr<ExprList> tlist = testlist();
 
-    tok = lexer.getToken();
+    tok = tokens.getToken();
 
-    if ( !tok->isCloseParen() ) {
+    if ( !tok.isCloseParen() ) {
         die(scope, "Expected `)`", tok);
     }
 
-    return std::make_unique<FunctionCall>(ID, std::move(tlist));
+    return arena.make<FunctionCall>(ID, std::move(tlist));
 
 }
 
-std::unique_ptr<ExprNode> Parser::factor() {
-    // This function parses the grammar rules:
-
-    // <factor> -> {'-'} <factor> | <atom>
-    // TODO: is this correct?
-    std::string scope = "*Parser::factor()";
-
-    if (debug)
-        std::cout << scope << std::endl;
-
-    auto tok = lexer.getToken();
-
-    if ( tok->isSubtractionOperator() ) {
-        std::unique_ptr<InfixExprNode> p = std::make_unique<InfixExprNode>(tok);
-        p->_left = factor();
-        p->_right = nullptr;
-
-        return p;
-
-    } else {
-
-        lexer.ungetToken();
-
-        if (debug)
-            std::cout << scope << " return" << std::endl;
-
-        auto left = atom();
-
-        if ( left->token()->isName() ) {
-            if ( lexer.getToken()->isOpenParen() ) {
-                //function
-                lexer.ungetToken();
-                return call( left->token() );
-            } else {
-                lexer.ungetToken();
-            }           
-
-        }
-
-        return left;
-
-        
-    }
-    die("Parser::factor", "ERROR", tok);
-    return nullptr;
-}
-
-
-std::unique_ptr<ExprNode> Parser::atom() {
+ArenaPtr<ExprNode> Parser::atom() {
     //This function parses the grammar rules:
 
     // <atom> -> <id>
@@ -723,20 +670,20 @@ std::unique_ptr<ExprNode> Parser::atom() {
     if (debug)
         std::cout << scope << std::endl;    
 
-    auto tok = lexer.getToken();
-
-    if ( tok->isName() )              // <id>
-        return std::make_unique<Variable>(tok);
-    else if ( tok->isWholeNumber() )  // <number>
-        return std::make_unique<WholeNumber>(tok);
-    else if ( tok->isString() )      // <string> NOT +
-        return std::make_unique<StringExp>(tok);
-    else if ( tok->isFloat() ) /*Swap to isDouble */
-        return std::make_unique<Double>(tok); 
-    else if ( tok->isOpenParen() ) {
-        std::unique_ptr<ExprNode> p = test();
-        auto token = lexer.getToken();
-        if ( !token->isCloseParen() )
+    auto tok = tokens.getToken();
+
+    if ( tok.isName() )              // <id>
+        return arena.make<Variable>(tok);
+    else if ( tok.isWholeNumber() )  // <number>
+        return arena.make<WholeNumber>(tok);
+    else if ( tok.isString() )      // <string> NOT +
+        return tokens.source().streaming() ? arena.make<StringExp>(tok, arena) : arena.make<StringExp>(tok);
+    else if ( tok.isFloat() ) /*Swap to isDouble */
+        return arena.make<Double>(tok); 
+    else if ( tok.isOpenParen() ) {
+        ArenaPtr<ExprNode> p = test();
+        auto token = tokens.getToken();
+        if ( !token.isCloseParen() )
             die("Parser::atom", "Expected close-parenthesis, instead got", token);
         return p;
     }
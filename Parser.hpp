@@ -6,62 +6,65 @@
 #include <string>
 
 #include "statements/Statement.hpp"
-#include "lex/Lexer.hpp"
+#include "lex/TokenStream.hpp"
 #include "ArithExpr.hpp"
 // #include "FunctionMap.hpp"
 class Parser { 
     public:
 
-        Parser(Lexer &);
+        // Every node the Parser builds lives in `arena`.
+        Parser(TokenStream &, Arena &);
 
         void die(
             std::string, 
             std::string, 
-            std::shared_ptr<Token>
+            const Token &
         );
 
         void getEOL(std::string);
 
-        std::unique_ptr<Statements> file_input();
+        ArenaPtr<Statements> file_input();
 
-        std::unique_ptr<Statement> stmt();
+        // The next top-level statement, or nullptr at end of input; lets a
+        // streamed program run as it is parsed.
+        ArenaPtr<Statement> next_stmt();
 
-        std::unique_ptr<Statement> simple_stmt();
+        ArenaPtr<Statement> stmt();
 
-        std::unique_ptr<AssignStmt> assign_stmt(std::shared_ptr<Token>);
+        ArenaPtr<Statement> simple_stmt();
+
+        ArenaPtr<AssignStmt> assign_stmt(const Token &);
         
-        std::unique_ptr<Statement> compound_stmt();
+        ArenaPtr<Statement> compound_stmt();
 
-        std::unique_ptr<PrintStatement> print_stmt();
+        ArenaPtr<PrintStatement> print_stmt();
 
-        std::unique_ptr<IfStatement> if_stmt();
-        std::unique_ptr<RangeStmt> for_stmt();
+        ArenaPtr<IfStatement> if_stmt();
+        ArenaPtr<RangeStmt> for_stmt();
 
-        std::unique_ptr<Statement> func_def();
-        std::vector<std::string> parameter_list();
+        ArenaPtr<Statement> func_def();
+        ArenaVector<Symbol> parameter_list();
 
-        std::unique_ptr<Statements> suite();
+        ArenaPtr<Statements> suite();
 
-        std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testlist();
+        ArenaPtr<ExprList> testlist();
 
 
-        std::unique_ptr<ExprNode> test();
-        std::unique_ptr<ExprNode> or_test();
-        std::unique_ptr<ExprNode> and_test();
-        std::unique_ptr<ExprNode> not_test();
-        std::unique_ptr<ExprNode> comparison();
-        std::unique_ptr<ExprNode> arith_expr();
-        
-        std::unique_ptr<ExprNode> term();
-        
-        std::unique_ptr<ExprNode> factor();
+        ArenaPtr<ExprNode> test();
+
+        // Operators and their precedence come from the table in Parser.cpp.
+        ArenaPtr<ExprNode> binary_expr(int minPrecedence);
+        ArenaPtr<ExprNode> unary_expr(int minPrecedence);
+
+        ArenaPtr<ExprNode> primary();
 
-        std::unique_ptr<ExprNode> call(std::shared_ptr<Token>);
+        ArenaPtr<ExprNode> call(const Token &);
 
-        std::unique_ptr<ExprNode> atom();
+        ArenaPtr<ExprNode> atom();
 
     private:
-        Lexer &lexer;
+        TokenStream &tokens;
+        Arena &arena;
         // std::shared_ptr<FunctionMap> _functionMap;
 
 };
@@ -0,0 +1,25 @@
+#include "Pool.hpp"
+
+namespace Pool {
+
+    thread_local ThreadLists lists;
+
+    // Carves a fresh slab into chunks of the class, hands out the first
+    // and threads the rest onto the free list.
+    void *refill(std::size_t sizeClass) {
+        std::size_t size = (sizeClass + 1) * granule;
+        std::size_t count = slabSize / size;
+
+        char *slab = static_cast<char *>(::operator new(slabSize));
+        lists.stats.slabs++;
+
+        Chunk *head = nullptr;
+        for (std::size_t i = count - 1; i > 0; i--) {
+            Chunk *chunk = reinterpret_cast<Chunk *>(slab + i * size);
+            chunk->next = head;
+            head = chunk;
+        }
+        lists.free[sizeClass] = head;
+        return slab;
+    }
+};
@@ -0,0 +1,75 @@
+#ifndef __POOL_HPP
+#define __POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Size-class free lists for the small objects the evaluator makes and
+// drops constantly (a string Value's StringDescriptor). Requests are
+// rounded up to a multiple of `granule`; each size class keeps a free
+// list per thread, so allocating and releasing is a pointer pop or push
+// with no locking. An empty list is refilled by carving a slab from the
+// global heap. Slabs are never given back: memory released stays on the
+// releasing thread's list for reuse, whichever thread allocated it.
+// Anything larger than the biggest class goes straight to operator new.
+namespace Pool {
+
+    const std::size_t granule = 16;
+    const std::size_t classes = 8;
+    const std::size_t slabSize = 16 * 1024;
+
+    // Counts for the calling thread.
+    struct Stats {
+        std::uint64_t allocations;   // requests served from a size class
+        std::uint64_t releases;      // returned to a size class
+        std::uint64_t slabs;         // times a class went to the global heap
+        std::uint64_t oversized;     // too big for any class
+    };
+
+    struct Chunk {
+        Chunk *next;
+    };
+
+    struct ThreadLists {
+        Chunk *free[classes];
+        Stats stats;
+    };
+
+    // Zero-initialized, so reaching it costs no guard check.
+    extern thread_local ThreadLists lists;
+
+    void *refill(std::size_t sizeClass);
+
+    inline void *allocate(std::size_t size) {
+        std::size_t sizeClass = (size - 1) / granule;
+        if ( sizeClass >= classes ) {
+            lists.stats.oversized++;
+            return ::operator new(size);
+        }
+
+        lists.stats.allocations++;
+        Chunk *chunk = lists.free[sizeClass];
+        if ( chunk == nullptr )
+            return refill(sizeClass);
+        lists.free[sizeClass] = chunk->next;
+        return chunk;
+    }
+
+    inline void release(void *p, std::size_t size) {
+        std::size_t sizeClass = (size - 1) / granule;
+        if ( sizeClass >= classes ) {
+            ::operator delete(p);
+            return;
+        }
+
+        lists.stats.releases++;
+        Chunk *chunk = static_cast<Chunk *>(p);
+        chunk->next = lists.free[sizeClass];
+        lists.free[sizeClass] = chunk;
+    }
+
+    inline const Stats &stats() { return lists.stats; }
+};
+
+#endif
@@ -0,0 +1,498 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "ProgramCache.hpp"
+#include "Debug.hpp"
+#include "statements/Statement.hpp"
+
+namespace {
+
+    // Bump whenever the layout below or any node's serialize() changes.
+    const std::uint32_t formatVersion = 2;
+
+    const char magic[8] = { 'P', 'Y', 'I', 'N', 'T', 'A', 'S', 'T' };
+
+    struct Header {
+        char magic[8];
+        std::uint32_t format;
+        std::uint32_t symbolCount;
+        std::uint64_t interpreter;
+        std::uint64_t sourceHash;
+        std::uint64_t sourceSize;
+        std::uint64_t symbolBytes;
+        std::uint64_t stringBytes;
+        std::uint64_t nodeBytes;
+        std::uint64_t checksum;     // of the three sections
+    };
+
+    // 64-bit FNV-1a; `seed` chains several buffers into one hash.
+    std::uint64_t hash(const char *p, std::size_t n, std::uint64_t seed = 0xcbf29ce484222325ull) {
+        for (std::size_t i = 0; i < n; i++) {
+            seed ^= static_cast<unsigned char>(p[i]);
+            seed *= 0x100000001b3ull;
+        }
+        return seed;
+    }
+
+    template <class T>
+    std::uint64_t hashValue(const T &value, std::uint64_t seed) {
+        return hash(reinterpret_cast<const char *>(&value), sizeof(value), seed);
+    }
+
+    // Changes whenever the interpreter is rebuilt, so nothing written by an
+    // older binary (whose nodes may differ) is ever read back.
+    std::uint64_t interpreterIdentity() {
+        std::uint64_t id = hashValue(formatVersion, hash(magic, sizeof(magic)));
+
+        struct stat st;
+        if ( stat("/proc/self/exe", &st) == 0 ) {
+            id = hashValue(st.st_ino, id);
+            id = hashValue(st.st_size, id);
+            id = hashValue(st.st_mtim.tv_sec, id);
+            id = hashValue(st.st_mtim.tv_nsec, id);
+        } else {
+            const char *built = __DATE__ " " __TIME__;
+            id = hash(built, strlen(built), id);
+        }
+        return id;
+    }
+
+    bool writeAll(int fd, const char *p, std::size_t n) {
+        while ( n > 0 ) {
+            ssize_t written = write(fd, p, n);
+            if ( written < 0 && errno == EINTR )
+                continue;
+            if ( written <= 0 )
+                return false;
+            p += written;
+            n -= written;
+        }
+        return true;
+    }
+
+    // Rebuilds a tree from ProgramWriter output. Anything out of place marks
+    // the reader bad instead of exiting, so the caller can fall back on parsing.
+    class ProgramReader {
+
+    public:
+        ProgramReader(std::string_view nodes, const std::vector<Symbol> &symbols, std::string_view strings, Arena &arena):
+            _cur{nodes.data()},
+            _end{nodes.data() + nodes.size()},
+            _symbols{symbols},
+            _strings{strings},
+            _arena{arena},
+            _ok{true}
+        {}
+
+        bool ok() const { return _ok; }
+        bool atEnd() const { return _cur == _end; }
+
+        ArenaPtr<Statements> statements() {
+            auto t = tag();
+            if ( t == ProgramWriter::NONE )
+                return nullptr;
+            if ( t != ProgramWriter::STATEMENTS )
+                return bad<Statements>();
+
+            ArenaPtr<Statements> stmts = _arena.make<Statements>(_arena);
+            for (std::uint32_t n = u32(); _ok && n > 0; n--)
+                stmts->addStatement(required(statement()));
+            return stmts;
+        }
+
+        ArenaPtr<Statement> statement() {
+
+            switch ( tag() ) {
+
+                case ProgramWriter::ASSIGN_STMT: {
+                    Symbol lhs = symbol();
+                    return _arena.make<AssignStmt>(lhs, required(expr()));
+                }
+
+                case ProgramWriter::IF_STATEMENT: {
+                    auto ifStatement = _arena.make<IfStatement>();
+                    ifStatement->addIfStmt(required(ifStmt()));
+                    ifStatement->addElifStmt(elifStmt());
+                    ifStatement->addElseStmt(elseStmt());
+                    return ifStatement;
+                }
+
+                case ProgramWriter::PRINT_STATEMENT:
+                    return _arena.make<PrintStatement>(required(exprList()));
+
+                case ProgramWriter::RANGE_STMT: {
+                    auto range = _arena.make<RangeStmt>(symbol());
+                    range->addTestList(required(exprList()));
+                    range->addStatements(required(statements()));
+                    return range;
+                }
+
+                case ProgramWriter::FUNCTION_DEFINITION: {
+                    Symbol name = symbol();
+                    ArenaVector<Symbol> params(_arena);
+                    for (std::uint32_t n = u32(); _ok && n > 0; n--)
+                        params.push_back(symbol());
+                    ArenaPtr<Statements> body = statements();
+                    bool added = u8() != 0;
+                    return _arena.make<FunctionDefinition>(name, params, std::move(body), added);
+                }
+
+                case ProgramWriter::FUNCTION_CALL_STATEMENT:
+                    return _arena.make<FunctionCallStatement>(required(expr()));
+
+                default:
+                    return bad<Statement>();
+            }
+        }
+
+        ArenaPtr<IfStmt> ifStmt() {
+            auto t = tag();
+            if ( t == ProgramWriter::NONE )
+                return nullptr;
+            if ( t != ProgramWriter::IF_STMT )
+                return bad<IfStmt>();
+
+            auto comp = required(expr());
+            return _arena.make<IfStmt>(std::move(comp), required(statements()));
+        }
+
+        ArenaPtr<ElifStmt> elifStmt() {
+            auto t = tag();
+            if ( t == ProgramWriter::NONE )
+                return nullptr;
+            if ( t != ProgramWriter::ELIF_STMT )
+                return bad<ElifStmt>();
+
+            auto elif = _arena.make<ElifStmt>(_arena);
+            for (std::uint32_t n = u32(); _ok && n > 0; n--) {
+                auto comp = required(expr());
+                elif->addStatement(std::move(comp), required(statements()));
+            }
+            return elif;
+        }
+
+        ArenaPtr<ElseStmt> elseStmt() {
+            auto t = tag();
+            if ( t == ProgramWriter::NONE )
+                return nullptr;
+            if ( t != ProgramWriter::ELSE_STMT )
+                return bad<ElseStmt>();
+
+            return _arena.make<ElseStmt>(required(statements()));
+        }
+
+        ArenaPtr<ExprList> exprList() {
+            auto t = tag();
+            if ( t == ProgramWriter::NONE )
+                return nullptr;
+            if ( t != ProgramWriter::EXPR_LIST )
+                return bad<ExprList>();
+
+            auto list = _arena.make<ExprList>(_arena);
+            for (std::uint32_t n = u32(); _ok && n > 0; n--)
+                list->push_back(required(expr()));
+            return list;
+        }
+
+        ArenaPtr<ExprNode> expr() {
+
+            switch ( tag() ) {
+                case ProgramWriter::NONE:
+                    return nullptr;
+
+                case ProgramWriter::INFIX_EXPR:      return joined<InfixExprNode>();
+                case ProgramWriter::COMPARISON_EXPR: return joined<ComparisonExprNode>();
+                case ProgramWriter::BOOLEAN_EXPR:    return joined<BooleanExprNode>();
+
+                case ProgramWriter::WHOLE_NUMBER:    return _arena.make<WholeNumber>(token());
+                case ProgramWriter::DOUBLE:          return _arena.make<Double>(token());
+                case ProgramWriter::VARIABLE:        return _arena.make<Variable>(token());
+                case ProgramWriter::STRING_EXP:      return _arena.make<StringExp>(token());
+                case ProgramWriter::BOOL_LITERAL:    return _arena.make<BoolLiteral>(token());
+
+                case ProgramWriter::FUNCTION_CALL: {
+                    Token name = token();
+                    return _arena.make<FunctionCall>(name, required(exprList()));
+                }
+
+                default:
+                    return bad<ExprNode>();
+            }
+        }
+
+    private:
+        template <class Node>
+        ArenaPtr<ExprNode> joined() {
+            ArenaPtr<Node> p = _arena.make<Node>(token());
+            p->_left = required(expr());
+            p->_right = expr();
+            return p;
+        }
+
+        Token token() {
+            auto kind = static_cast<Token::Kind>(u8());
+            auto op = static_cast<Token::Op>(u8());
+            Span span;
+            span.offset = u32();
+            span.line = u32();
+            span.column = static_cast<std::uint16_t>(u32());
+            span.length = static_cast<std::uint16_t>(u32());
+
+            if ( kind > Token::FLOAT || op > Token::WHILE )
+                _ok = false;
+
+            Token tok(kind, op);
+            if ( kind == Token::NAME ) {
+                Symbol s = symbol();
+                tok.setName(s, Symbols::name(s));
+            } else if ( kind == Token::STRING ) {
+                std::uint32_t offset = u32(), len = u32();
+                if ( offset > _strings.size() || len > _strings.size() - offset )
+                    _ok = false;
+                else
+                    tok.setString(_strings.substr(offset, len));
+            } else if ( kind == Token::WHOLE_NUMBER ) {
+                std::uint64_t n = u64();
+                tok.setWholeNumber(static_cast<std::int64_t>((n >> 1) ^ (0 - (n & 1))));
+            } else if ( kind == Token::FLOAT ) {
+                tok.setFloat(pod<double>());
+            }
+            tok.setSpan(span);
+            return tok;
+        }
+
+        Symbol symbol() {
+            std::uint32_t index = u32();
+            if ( index >= _symbols.size() ) {
+                _ok = false;
+                return 0;
+            }
+            return _symbols[index];
+        }
+
+        ProgramWriter::Tag tag() { return static_cast<ProgramWriter::Tag>(u8()); }
+        std::uint8_t u8() { return pod<std::uint8_t>(); }
+
+        std::uint32_t u32() {
+            std::uint64_t value = u64();
+            if ( value > UINT32_MAX )
+                _ok = false;
+            return static_cast<std::uint32_t>(value);
+        }
+
+        std::uint64_t u64() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                std::uint8_t byte = u8();
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if ( (byte & 0x80) == 0 )
+                    return value;
+            }
+            _ok = false;
+            return 0;
+        }
+
+        template <class T>
+        T pod() {
+            T value{};
+            if ( static_cast<std::size_t>(_end - _cur) < sizeof(T) ) {
+                _ok = false;
+                _cur = _end;
+                return value;
+            }
+            std::memcpy(&value, _cur, sizeof(T));
+            _cur += sizeof(T);
+            return value;
+        }
+
+        template <class T>
+        ArenaPtr<T> required(ArenaPtr<T> p) {
+            if ( p == nullptr )
+                _ok = false;
+            return p;
+        }
+
+        template <class T>
+        ArenaPtr<T> bad() {
+            _ok = false;
+            return nullptr;
+        }
+
+        const char *_cur;
+        const char *_end;
+        const std::vector<Symbol> &_symbols;
+        std::string_view _strings;
+        Arena &_arena;
+        bool _ok;
+    };
+}
+
+// ProgramWriter START
+void ProgramWriter::symbol(Symbol s) {
+    auto found = _symbolIndex.find(s);
+    if ( found == _symbolIndex.end() ) {
+        std::string_view name = Symbols::name(s);
+        std::uint32_t len = static_cast<std::uint32_t>(name.size());
+        _symbols.append(reinterpret_cast<const char *>(&len), sizeof(len));
+        _symbols.append(name.data(), name.size());
+        found = _symbolIndex.emplace(s, static_cast<std::uint32_t>(_symbolIndex.size())).first;
+    }
+    u32(found->second);
+}
+
+void ProgramWriter::token(const Token &tok) {
+    u8(tok.kind());
+    u8(tok.op());
+    u32(tok.span().offset);
+    u32(tok.span().line);
+    u32(tok.span().column);
+    u32(tok.span().length);
+
+    if ( tok.isName() ) {
+        symbol(tok.getSymbol());
+    } else if ( tok.isString() ) {
+        std::string_view text = tok.getText();
+        u32(static_cast<std::uint32_t>(_strings.size()));
+        u32(static_cast<std::uint32_t>(text.size()));
+        _strings.append(text.data(), text.size());
+    } else if ( tok.isWholeNumber() ) {
+        // Zigzag, so small negative numbers stay short too.
+        std::uint64_t n = static_cast<std::uint64_t>(tok.getWholeNumber());
+        u64((n << 1) ^ (tok.getWholeNumber() < 0 ? ~0ull : 0));
+    } else if ( tok.isFloat() ) {
+        double d = tok.getFloat();
+        raw(&d, sizeof(d));
+    }
+}
+
+void ProgramWriter::statements(Statements *stmts) {
+    node(stmts);
+}
+
+void ProgramWriter::exprList(ExprList *list) {
+    if ( list == nullptr ) {
+        tag(NONE);
+        return;
+    }
+    tag(EXPR_LIST);
+    u32(static_cast<std::uint32_t>(list->size()));
+    for (auto &&item : *list)
+        node(item.get());
+}
+// ProgramWriter END
+
+// ProgramCache START
+ProgramCache::ProgramCache(std::string dir, const Source &source):
+    _dir{dir},
+    _interpreter{interpreterIdentity()},
+    _sourceHash{hash(source.begin(), source.size())},
+    _sourceSize{source.size()}
+{
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", (unsigned long long) hashValue(_interpreter, _sourceHash));
+    _path = _dir + "/" + key + ".ast";
+}
+
+ArenaPtr<Statements> ProgramCache::load(Arena &arena) {
+
+    std::unique_ptr<Source> file = Source::open(_path);
+    if ( file == nullptr || file->streaming() || file->size() < sizeof(Header) )
+        return nullptr;
+
+    Header header;
+    std::memcpy(&header, file->begin(), sizeof(header));
+
+    const char *body = file->begin() + sizeof(header);
+    std::size_t bodySize = file->size() - sizeof(header);
+
+    if ( std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.format != formatVersion ||
+         header.interpreter != _interpreter || header.sourceHash != _sourceHash || header.sourceSize != _sourceSize ||
+         header.symbolBytes > bodySize || header.stringBytes > bodySize - header.symbolBytes ||
+         header.nodeBytes != bodySize - header.symbolBytes - header.stringBytes ||
+         header.checksum != hash(body, bodySize) ) {
+        if (debug)
+            std::cout << "ProgramCache::load stale or corrupt " << _path << std::endl;
+        return nullptr;
+    }
+
+    std::vector<Symbol> symbols;
+    symbols.reserve(header.symbolCount);
+    const char *p = body, *symbolsEnd = body + header.symbolBytes;
+    for (std::uint32_t i = 0; i < header.symbolCount; i++) {
+        std::uint32_t len;
+        if ( symbolsEnd - p < (std::ptrdiff_t) sizeof(len) )
+            return nullptr;
+        std::memcpy(&len, p, sizeof(len));
+        p += sizeof(len);
+        if ( symbolsEnd - p < (std::ptrdiff_t) len )
+            return nullptr;
+        symbols.push_back(Symbols::intern(std::string_view(p, len)));
+        p += len;
+    }
+
+    std::string_view strings(symbolsEnd, header.stringBytes);
+    std::string_view nodes(symbolsEnd + header.stringBytes, header.nodeBytes);
+
+    Arena::Mark mark = arena.mark();
+    ProgramReader reader(nodes, symbols, strings, arena);
+    ArenaPtr<Statements> stmts = reader.statements();
+
+    if ( !reader.ok() || !reader.atEnd() || stmts == nullptr ) {
+        if (debug)
+            std::cout << "ProgramCache::load malformed " << _path << std::endl;
+        arena.rewind(mark);
+        return nullptr;
+    }
+
+    _mapped = std::move(file);
+    return stmts;
+}
+
+bool ProgramCache::store(Statements &stmts) {
+
+    ProgramWriter writer;
+    writer.statements(&stmts);
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.format = formatVersion;
+    header.symbolCount = writer.symbolCount();
+    header.interpreter = _interpreter;
+    header.sourceHash = _sourceHash;
+    header.sourceSize = _sourceSize;
+    header.symbolBytes = writer.symbolSection().size();
+    header.stringBytes = writer.stringSection().size();
+    header.nodeBytes = writer.nodeSection().size();
+
+    std::uint64_t checksum = hash(writer.symbolSection().data(), writer.symbolSection().size());
+    checksum = hash(writer.stringSection().data(), writer.stringSection().size(), checksum);
+    header.checksum = hash(writer.nodeSection().data(), writer.nodeSection().size(), checksum);
+
+    if ( mkdir(_dir.c_str(), 0777) != 0 && errno != EEXIST )
+        return false;
+
+    // Written aside and renamed into place, so a reader never sees half a file.
+    std::string tmp = _path + ".tmp" + std::to_string(getpid());
+    int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if ( fd < 0 )
+        return false;
+
+    bool ok = writeAll(fd, reinterpret_cast<const char *>(&header), sizeof(header)) &&
+              writeAll(fd, writer.symbolSection().data(), writer.symbolSection().size()) &&
+              writeAll(fd, writer.stringSection().data(), writer.stringSection().size()) &&
+              writeAll(fd, writer.nodeSection().data(), writer.nodeSection().size());
+
+    ok = close(fd) == 0 && ok;
+    ok = ok && rename(tmp.c_str(), _path.c_str()) == 0;
+
+    if ( !ok )
+        unlink(tmp.c_str());
+    return ok;
+}
+// ProgramCache END
@@ -0,0 +1,107 @@
+#ifndef __PROGRAM_CACHE_HPP
+#define __PROGRAM_CACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Arena.hpp"
+#include "ArithExpr.hpp"
+#include "Token.hpp"
+#include "lex/Source.hpp"
+
+class Statements;
+
+// Compiled programs kept between runs. Once a program has been parsed, its
+// Statements tree is serialized to <dir>/<key>.ast, where the key hashes the
+// source text together with the identity of the interpreter binary. A later
+// run of the same text maps that file and rebuilds the tree from it without
+// lexing or parsing. Names are re-interned on load; string literals are used
+// in place, straight out of the mapping.
+//
+// A file that is truncated, fails its checksum, or was written for other
+// text or by another build is a miss, and is overwritten by the next store().
+class ProgramCache {
+
+public:
+    ProgramCache(std::string dir, const Source &source);
+
+    // The cached tree, built in `arena`, or nullptr on a miss. The tree
+    // points into the mapping, which lives as long as this ProgramCache.
+    ArenaPtr<Statements> load(Arena &arena);
+
+    // Must run before the tree is evaluated (a def gives its body away).
+    // Returns false, leaving the cache as it was, if the file can't be written.
+    bool store(Statements &stmts);
+
+    const std::string &path() const { return _path; }
+
+private:
+    std::string _dir;
+    std::string _path;
+    std::uint64_t _interpreter;
+    std::uint64_t _sourceHash;
+    std::uint64_t _sourceSize;
+    std::unique_ptr<Source> _mapped;
+};
+
+// What every Statement, Comparison and ExprNode serialize() writes into.
+// A node writes its Tag and then its fields; children go through node(),
+// which writes NONE for an empty slot.
+class ProgramWriter {
+
+public:
+    enum Tag : std::uint8_t {
+        NONE,
+        STATEMENTS, EXPR_LIST,
+
+        ASSIGN_STMT, IF_STATEMENT, PRINT_STATEMENT, RANGE_STMT,
+        FUNCTION_DEFINITION, FUNCTION_CALL_STATEMENT,
+        IF_STMT, ELIF_STMT, ELSE_STMT,
+
+        INFIX_EXPR, COMPARISON_EXPR, BOOLEAN_EXPR,
+        WHOLE_NUMBER, DOUBLE, VARIABLE, STRING_EXP, FUNCTION_CALL, BOOL_LITERAL
+    };
+
+    void tag(Tag t) { u8(t); }
+    void u8(std::uint8_t v) { _nodes.push_back(static_cast<char>(v)); }
+    // LEB128: most counts, indices and span fields take one or two bytes.
+    void u32(std::uint32_t v) { u64(v); }
+    void u64(std::uint64_t v) {
+        for ( ; v >= 0x80; v >>= 7)
+            u8(static_cast<std::uint8_t>(v | 0x80));
+        u8(static_cast<std::uint8_t>(v));
+    }
+
+    void symbol(Symbol s);
+    void token(const Token &tok);
+
+    template <class Node>
+    void node(Node *n) {
+        if ( n == nullptr )
+            tag(NONE);
+        else
+            n->serialize(*this);
+    }
+
+    void statements(Statements *stmts);
+    void exprList(ExprList *list);
+
+    // The three sections of the file, in order.
+    const std::string &symbolSection() const { return _symbols; }
+    const std::string &stringSection() const { return _strings; }
+    const std::string &nodeSection() const { return _nodes; }
+    std::uint32_t symbolCount() const { return static_cast<std::uint32_t>(_symbolIndex.size()); }
+
+private:
+    void raw(const void *p, std::size_t n) { _nodes.append(static_cast<const char *>(p), n); }
+
+    std::string _symbols;
+    std::string _strings;
+    std::string _nodes;
+    std::unordered_map<Symbol, std::uint32_t> _symbolIndex;
+};
+
+#endif
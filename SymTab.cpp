@@ -1,6 +1,7 @@
 #include <stack>
 #include <iostream>
 #include "SymTab.hpp"
+#include "DescriptorFunctions.hpp"
 
 // https://stackoverflow.com/questions/41871115/why-would-i-stdmove-an-stdshared-ptr
 
@@ -12,106 +13,105 @@
 }*/
 
 
-void SymTab::addDescriptor(std::string vName, std::shared_ptr<NumberDescriptor> descriptor) {
+void SymTab::addDescriptor(Symbol vName, Value descriptor) {
     if ( symTab.size() > 0 )
         (symTab.top())[vName] = std::move(descriptor);
     else
-        globalSymTab[vName] = std::move(descriptor);
+        globalSlot(vName) = std::move(descriptor);
 }
 
-void SymTab::createEntryFor(std::string vName, int value) {
+void SymTab::createEntryFor(Symbol vName, std::int64_t value) {
 
     if (debug)
         std::cout << "SymTab::createEntryFor(INT) ->" << value << "<-" << std::endl;
-    auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::INTEGER);
-    descriptor->_value.intValue = value;
-    addDescriptor(vName, descriptor);
+    addDescriptor(vName, Descriptor::Int::createIntDescriptor(value));
     //globalSymTab[vName] = std::move(descriptor);
 }
 
-void SymTab::createEntryFor(std::string vName, double value) {
+void SymTab::createEntryFor(Symbol vName, double value) {
 
     if (debug)
         std::cout << "SymTab::createEntryFor(DOUBLE) ->" << value << "<-" << std::endl;
 
-    auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::DOUBLE);
-    descriptor->_value.doubleValue = value;
-    addDescriptor(vName, descriptor);
+    addDescriptor(vName, Descriptor::Double::createDoubleDescriptor(value));
 }
 
-void SymTab::createEntryFor(std::string vName, bool value) {
+void SymTab::createEntryFor(Symbol vName, bool value) {
 
     if (debug)
         std::cout << "SymTab::createEntryFor(BOOL) ->" << value << "<-" << std::endl;
 
-    auto descriptor = std::make_shared<NumberDescriptor>(TypeDescriptor::BOOL);
-    descriptor->_value.boolValue = (int) value;
-    addDescriptor(vName, descriptor);
+    addDescriptor(vName, Descriptor::Bool::createBooleanDescriptor(value));
 }
 
-void SymTab::createEntryFor(std::string vName, std::string value) {
+void SymTab::createEntryFor(Symbol vName, std::string value) {
     if (debug)
         std::cout << "SymTab::createEntryFor(STRING) ->" << value << "<-" << std::endl;
 
-    auto descriptor = std::make_shared<StringDescriptor>(TypeDescriptor::STRING);
-    descriptor->_stringValue = value;
-    if ( symTab.size() > 0 )
-        (symTab.top())[vName] = std::move(descriptor);
-    else
-        globalSymTab[vName] = std::move(descriptor);
+    addDescriptor(vName, Descriptor::String::createStringDescriptor(std::move(value)));
 }
 
-void SymTab::setValueFor(std::string vName, std::shared_ptr<TypeDescriptor> sp) {
+void SymTab::setValueFor(Symbol vName, Value sp) {
     
     if ( symTab.size() > 0 )
-        (symTab.top())[vName] = /*std::move(*/sp/*)*/;
+        (symTab.top())[vName] = std::move(sp);
     else
-        globalSymTab[vName] = /*std::move(*/sp/*)*/;
+        globalSlot(vName) = std::move(sp);
 
     
     
     // globalSymTab[vName] = std::move(sp);
 }
 
-bool SymTab::isDefined(std::string vName) {
+bool SymTab::isDefined(Symbol vName) {
     
     if ( symTab.size() > 0 )
         return (symTab.top()).find(vName) != (symTab.top()).end();
-    return globalSymTab.find(vName) != globalSymTab.end();
+    return vName < globalSymTab.size() && globalSymTab[vName].defined();
 }
 
-bool SymTab::erase(std::string vName) {
+bool SymTab::erase(Symbol vName) {
     if (isDefined(vName)) {
 
         if ( symTab.size() > 0 ) {
             auto iterator = (symTab.top()).find(vName);
             (symTab.top()).erase(iterator);
         } else {
-            auto iterator = globalSymTab.find(vName);
-            globalSymTab.erase(iterator);
+            globalSymTab[vName] = Value();
         }
         return true;
     }
     return false;
 }
 
-TypeDescriptor *SymTab::getValueFor(std::string vName) {
+Value *SymTab::getValueFor(Symbol vName) {
 
     if ( !isDefined(vName) ) {
-        std::cout << "SymTab::getValueFor: " << vName << " has not been defined.\n";
+        std::cout << "SymTab::getValueFor: " << Symbols::name(vName) << " has not been defined.\n";
         exit(1);
     }
 
     if (debug)
-        std::cout << "SymTab::getValueFor: " << vName << "\n";
+        std::cout << "SymTab::getValueFor: " << Symbols::name(vName) << "\n";
 
-    return globalSymTab.find(vName)->second.get();
+    return &globalSymTab[vName];
+
+}
+
+Value &SymTab::globalSlot(Symbol vName) {
+    if ( vName >= globalSymTab.size() )
+        globalSymTab.resize(Symbols::count());
+    return globalSymTab[vName];
+}
 
+void SymTab::reserveSlots(std::size_t count) {
+    if ( count > globalSymTab.size() )
+        globalSymTab.resize(count);
 }
 
 void SymTab::openScope() {
 
-    std::map<std::string, std::shared_ptr<TypeDescriptor>> newScope;
+    std::unordered_map<Symbol, Value> newScope;
     symTab.push(newScope);
 }
 
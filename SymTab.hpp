@@ -4,60 +4,71 @@
 #include <string>
 #include <stack>
 #include <map>
+#include <unordered_map>
+#include <vector>
+#include <memory>
 
 #include "Descriptor.hpp"
+#include "Symbols.hpp"
 
 // #include "./statements/Statement.hpp"
 class FunctionDefinition;
 
 
-// This is a flat and integer-based symbol table. It allows for variables to be
+// This is a flat and integer-based symbol table, keyed by interned Symbols. It allows for variables to be
 // initialized, determines if a give variable has been defined or not, and if
 // a variable has been defined, it returns its value.
 
 class SymTab {
 public:
-    bool isDefined(std::string vName);
-    bool erase(std::string vName);
-    void createEntryFor(std::string, int);
-    void createEntryFor(std::string, double);
-    void createEntryFor(std::string, bool);
-    void createEntryFor(std::string, std::string);
-
-    void setValueFor(std::string, std::shared_ptr<TypeDescriptor>);
+    bool isDefined(Symbol vName);
+    bool erase(Symbol vName);
+    void createEntryFor(Symbol, std::int64_t);
+    void createEntryFor(Symbol, double);
+    void createEntryFor(Symbol, bool);
+    void createEntryFor(Symbol, std::string);
+
+    void setValueFor(Symbol, Value);
     // int getValueFor(std::string vName);
 
-    TypeDescriptor *getValueFor(std::string);
+    Value *getValueFor(Symbol);
 
     void openScope();
     void closeScope();
 
-    std::shared_ptr<TypeDescriptor> getReturnValue() { return _returnValue; }
-    void setReturnValue(std::shared_ptr<TypeDescriptor> rv) { _returnValue = rv; }
+    // A global variable's slot is its Symbol. After reserveSlots(n), slot(s)
+    // for any s < n is a plain index into the global frame: no scope,
+    // bounds or definedness check (an UNDEFINED slot is an undefined name).
+    // Only valid while no scope is open; see passes/Resolve.hpp.
+    void reserveSlots(std::size_t count);
+    Value &slot(Symbol s) { return globalSymTab[s]; }
 
-    void setFunction(std::string fName, std::shared_ptr<FunctionDefinition> fDef) { _functionTable[fName] = fDef; }
-    std::shared_ptr<FunctionDefinition> getFunction(std::string fName) { return _functionTable[fName]; }
+    const Value &getReturnValue() { return _returnValue; }
+    void setReturnValue(Value rv) { _returnValue = std::move(rv); }
+
+    void setFunction(Symbol fName, std::shared_ptr<FunctionDefinition> fDef) { _functionTable[fName] = fDef; }
+    std::shared_ptr<FunctionDefinition> getFunction(Symbol fName) { return _functionTable[fName]; }
 
 private:
 
-    void addDescriptor(std::string,  std::shared_ptr<NumberDescriptor>);
+    void addDescriptor(Symbol, Value);
 
 
-    std::map<
-        std::string, 
-        std::shared_ptr<TypeDescriptor>
-    > globalSymTab;
+    // Symbols are dense, so globals live in a vector indexed by Symbol;
+    // an UNDEFINED slot is an undefined name.
+    std::vector<Value> globalSymTab;
+    Value &globalSlot(Symbol);
 
-    std::map<
-        std::string,
+    std::unordered_map<
+        Symbol,
         std::shared_ptr<FunctionDefinition>
     > _functionTable;
 
     std::stack<
-        std::map< std::string, std::shared_ptr<TypeDescriptor>
-	>> symTab;
+        std::unordered_map< Symbol, Value >
+    > symTab;
 
-    std::shared_ptr<TypeDescriptor> _returnValue;
+    Value _returnValue;
 };
 
 #endif //EXPRINTER_SYMTAB_HPP
@@ -0,0 +1,72 @@
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Symbols.hpp"
+
+namespace {
+
+    // A deque never moves its elements, so the views the index and the
+    // Tokens hold into these strings stay valid.
+    std::deque<std::string> &names() {
+        static std::deque<std::string> names;
+        return names;
+    }
+
+    std::unordered_map<std::string_view, Symbol> &index() {
+        static std::unordered_map<std::string_view, Symbol> index;
+        return index;
+    }
+
+    std::mutex &lock() {
+        static std::mutex lock;
+        return lock;
+    }
+}
+
+namespace Symbols {
+
+    Symbol intern(std::string_view name, std::string_view *stored) {
+
+        // Each thread remembers the names it has already looked up, so the
+        // shared table is only locked for a name's first use on a thread.
+        // Its keys are the interned copies.
+        thread_local std::unordered_map<std::string_view, Symbol> seen;
+
+        auto known = seen.find(name);
+        if (known != seen.end()) {
+            if (stored != nullptr)
+                *stored = known->first;
+            return known->second;
+        }
+
+        std::lock_guard<std::mutex> guard(lock());
+
+        Symbol symbol;
+        auto found = index().find(name);
+        if (found != index().end()) {
+            symbol = found->second;
+        } else {
+            symbol = static_cast<Symbol>(names().size());
+            names().emplace_back(name);
+            index().emplace(names().back(), symbol);
+        }
+
+        seen.emplace(names()[symbol], symbol);
+        if (stored != nullptr)
+            *stored = names()[symbol];
+        return symbol;
+    }
+
+    // The deque may be growing under another thread's intern().
+    std::string_view name(Symbol symbol) {
+        std::lock_guard<std::mutex> guard(lock());
+        return names()[symbol];
+    }
+
+    std::size_t count() {
+        std::lock_guard<std::mutex> guard(lock());
+        return names().size();
+    }
+};
@@ -0,0 +1,31 @@
+#ifndef __SYMBOLS_HPP
+#define __SYMBOLS_HPP
+
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+// Every identifier in the program, interned by the Lexer. A Symbol is a
+// dense 32-bit ID: the first distinct name seen is 0, the next 1, and so on,
+// so everything past the Lexer compares, hashes and indexes integers rather
+// than strings. The text stays available, at a stable address, for
+// diagnostics and dumps.
+//
+// Every function may be called from several threads at once
+// (ParallelParser's workers intern names while others read them); IDs are
+// then handed out in whatever order the threads get there.
+using Symbol = std::uint32_t;
+
+namespace Symbols {
+
+    // The ID of `name`, adding it if it is new. If `stored` is given it is
+    // set to the interned text, which saves the Lexer a name() lookup.
+    Symbol intern(std::string_view name, std::string_view *stored = nullptr);
+
+    std::string_view name(Symbol symbol);
+
+    // Number of distinct names so far; every Symbol is below it.
+    std::size_t count();
+};
+
+#endif
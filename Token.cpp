@@ -5,31 +5,71 @@
 #include "Debug.hpp"
 
 Token::Token():
-  _name{""},
-  _relExp{""},
-  _keyword{""},
-  _eof{false},
-  _eol{false},
-  _isFloat{false},
-  _isWholeNumber{false},
-  _symbol{'\0'},
-  _wholeNumber{0},
-  _float{0.}
-  {}
+  _kind{NONE},
+  _op{NO_OP},
+  _span{0, 0, 0, 0}
+{
+  _value.wholeNumber = 0;
+}
+
+Token::Token(Kind kind, Op op):
+  _kind{kind},
+  _op{op},
+  _span{0, 0, 0, 0}
+{
+  _value.wholeNumber = 0;
+}
+
+void Token::symbol(char c) {
+  _kind = SYMBOL;
+  switch (c) {
+    case '(': _op = OPEN_PAREN;           break;
+    case ')': _op = CLOSE_PAREN;          break;
+    case '{': _op = OPEN_BRACKET;         break;
+    case '}': _op = CLOSE_BRACKET;        break;
+    case '[': _op = OPEN_SQUARE_BRACKET;  break;
+    case ']': _op = CLOSE_SQUARE_BRACKET; break;
+    case ':': _op = COLON;                break;
+    case ';': _op = SEMICOLON;            break;
+    case ',': _op = COMMA;                break;
+    case '*': _op = MULTIPLY;             break;
+    case '+': _op = ADD;                  break;
+    case '-': _op = SUBTRACT;             break;
+    case '%': _op = MODULO;               break;
+    case '/': _op = DIVIDE;               break;
+    default:
+      std::cout << "Token::symbol - unknown symbol ->" << c << "<-" << std::endl;
+      exit(1);
+  }
+}
 
-Token::Token(std::string tok) {
-  _keyword = tok;
-} 
+char Token::symbol() const {
+  if (_kind != SYMBOL)
+    return '\0';
+
+  static const char symbols[] = "\0(){}[]:;,*+-%/";
+  return symbols[_op];
+}
+
+std::string Token::getRelOp() const {
+  switch (_op) {
+    case REL_GT:     return ">";
+    case REL_LT:     return "<";
+    case REL_GTE:    return ">=";
+    case REL_LTE:    return "<=";
+    case REL_EQ:     return "==";
+    case REL_NOT_EQ: return "!=";
+    case REL_EQML:   return "<>";
+    case ASSIGN:     return "=";
+    default:         return "";
+  }
+}
 
 void Token::dumpData() const {
-  std::cout << "_name: " << _name << std::endl;
-  std::cout << "_relExp: " << _relExp << std::endl;
-  std::cout << "_keyword: " << _keyword << std::endl;
-  std::cout << "_eof: " << _eof << std::endl;
-  std::cout << "_eol: " << _eol << std::endl;
-  std::cout << "_isWholeNumber: " << _isWholeNumber << std::endl;
-  std::cout << "_symbol: " << _symbol << std::endl;
-  std::cout << "_wholeNumber: " << _wholeNumber << std::endl;
+  std::cout << "_kind: " << (int) _kind << std::endl;
+  std::cout << "_op: " << (int) _op << std::endl;
+  std::cout << "_span: " << _span.line << ":" << _span.column << " +" << _span.length << std::endl;
+  std::cout << "_wholeNumber: " << _value.wholeNumber << std::endl;
 }
 
 void Token::print() const {
@@ -49,7 +89,7 @@ void Token::print() const {
     else if ( isSubtractionOperator() )     std::cout << "-" ;
     else if ( isModuloOperator() )          std::cout << "%" ;
     else if ( isDivisionOperator() )        std::cout << "/" ;
-    else if ( isName() )                    std::cout << getName();
+    else if ( isName() )                    std::cout << getText();
     else if ( isWholeNumber() )             std::cout << getWholeNumber();
     else if ( isFloat() )                   std::cout << getFloat();
     else if ( isRelOp() )                   std::cout << getRelOp();
@@ -72,12 +112,14 @@ void Token::print() const {
       else if ( isPeriod() ) std::cout << ".";
       else if ( isFunc() )   std::cout << "def";
       else if ( isLen() )    std::cout << "len";
+      else if ( isReturn() ) std::cout << "return";
+      else if ( _op == WHILE ) std::cout << "while";
       else {
         std::cout << "Unidentified Keyword ... update Token.cpp / Token.hpp";
       }
     }
     else if ( isString() ) {
-      std::cout << getString();
+      std::cout << getText();
     } else {
       std::cout << "Uninitialized token.\n";
       dumpData();
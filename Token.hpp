@@ -2,135 +2,151 @@
 #define EXPRINTER_TOKEN_HPP
 
 #include <string>
+#include <string_view>
+#include <cstdint>
+
+#include "Symbols.hpp"
+
+// Where a token came from: byte offset into the Source, 1-based line and
+// column, and length in bytes. Diagnostics are rebuilt from these on demand.
+struct Span {
+    std::uint32_t offset;
+    std::uint32_t line;
+    std::uint16_t column;
+    std::uint16_t length;
+};
 
+// A Token is a kind tag, an operator/keyword tag, its Span and a small
+// payload. Every classification predicate below is a single integer compare;
+// the payload holds whichever of the number / string slice the kind calls for.
 class Token {
 
 public:
-    Token();
-    Token(std::string tok);
-
-    bool &eof()  { return _eof; }
-    bool &eol()  { return _eol; }
-
-    bool eof() const { return _eof; }
-    bool eol() const  { return _eol; }
-
-    bool isOpenParen() const  { return _symbol == '('; }
-    bool isCloseParen() const { return _symbol == ')'; }
-
-    bool isOpenBracket()  const { return _symbol == '{'; }
-    bool isCloseBracket() const { return _symbol == '}'; }
-
-    bool isOpenSquareBracket()  const { return _symbol == '['; }
-    bool isCloseSquareBracket() const { return _symbol == ']'; }
+    enum Kind : std::uint8_t {
+        NONE, END_OF_FILE, END_OF_LINE, SYMBOL, REL_OP, KEYWORD, NAME, STRING, WHOLE_NUMBER, FLOAT
+    };
 
+    enum Op : std::uint8_t {
+        NO_OP,
 
+        // SYMBOL
+        OPEN_PAREN, CLOSE_PAREN, OPEN_BRACKET, CLOSE_BRACKET, OPEN_SQUARE_BRACKET, CLOSE_SQUARE_BRACKET,
+        COLON, SEMICOLON, COMMA, MULTIPLY, ADD, SUBTRACT, MODULO, DIVIDE,
 
-    
+        // REL_OP
+        REL_GT, REL_LT, REL_GTE, REL_LTE, REL_EQ, REL_NOT_EQ, REL_EQML, ASSIGN,
 
-    void symbol(char c) { _symbol = c; }
-    char symbol() { return _symbol; }
+        // KEYWORD
+        PRINT, FOR, IF, ELIF, ELSE, INDENT, DEDENT, AND, OR, NOT, IN, RANGE, DEF, LEN, PERIOD, RETURN, WHILE
+    };
 
-    void relExp(std::string exp) { _relExp = exp; }
-    std::string getRelOp() const { return _relExp; }
-
-    bool isRelGT() const     { return _relExp == ">";  } //done
-    bool isRelLT() const     { return _relExp == "<";  } //done
-    bool isRelGTE() const    { return _relExp == ">="; } //done
-    bool isRelLTE() const    { return _relExp == "<="; } //done
-    bool isRelEQ() const     { return _relExp == "=="; } //done
-    bool isRelNotEQ() const  { return _relExp == "!="; } //done
-    bool isRelEQML() const   { return _relExp == "<>"; } //done
-    bool isRelAssign() const { return _relExp == "=";  }
-
-
-    bool isRelOp() const {
-      return
-        _relExp != "" && (
-        isRelGT()     ||
-        isRelLT()     ||
-        isRelGTE()    ||
-        isRelLTE()    ||
-        isRelEQ()     ||
-        isRelNotEQ()  ||
-        isRelEQML()   ||
-        isRelAssign()     //needs to be taken out
-      );
-    }
-
-    bool isCompOp() const { return isRelOp() && !isRelAssign(); }
-
-    bool isColon()     const { return _symbol == ':'; }
-    bool isSemiColon() const { return _symbol == ';'; }
-    bool isAssignmentOperator() const     { return _relExp == "="; }
-    bool isMultiplicationOperator() const { return _symbol == '*'; }
-    bool isAdditionOperator() const       { return _symbol == '+'; }
-    bool isSubtractionOperator() const    { return _symbol == '-'; }
-    bool isModuloOperator() const         { return _symbol == '%'; }
-    bool isDivisionOperator() const       { return _symbol == '/'; }
-    bool isComma() const                  { return _symbol == ','; }
-    bool isArithmeticOperator() const {
-        return isMultiplicationOperator() ||
-               isAdditionOperator() ||
-               isSubtractionOperator() ||
-               isModuloOperator() ||
-               isDivisionOperator();
-    }
-
-  
-
-    bool isName() const                   { return _name.length() > 0; }
-    std::string getName() const                  { return _name; }
-    void setName(std::string n) { _name = n; }
-
-    bool isKeyword() const {
-      return _keyword.length() > 0;
-    }
-
-    bool isString() const { return _str.length() > 0; }
-    
-    std::string getString() const {
-      return _str;
-    }
-
-    void setString(std::string str) {
-      _str = str;
-    }
-
-    void setKeyword(std::string keyword)  {
-      _keyword = keyword;
+    Token();
+    Token(Kind kind, Op op);
+
+    Kind kind() const { return _kind; }
+    Op op() const     { return _op; }
+
+    const Span &span() const { return _span; }
+    void setSpan(const Span &span) { _span = span; }
+
+    void setEof() { _kind = END_OF_FILE; }
+    void setEol() { _kind = END_OF_LINE; }
+
+    bool eof() const { return _kind == END_OF_FILE; }
+    bool eol() const  { return _kind == END_OF_LINE; }
+
+    bool isOpenParen() const  { return _op == OPEN_PAREN; }
+    bool isCloseParen() const { return _op == CLOSE_PAREN; }
+
+    bool isOpenBracket()  const { return _op == OPEN_BRACKET; }
+    bool isCloseBracket() const { return _op == CLOSE_BRACKET; }
+
+    bool isOpenSquareBracket()  const { return _op == OPEN_SQUARE_BRACKET; }
+    bool isCloseSquareBracket() const { return _op == CLOSE_SQUARE_BRACKET; }
+
+    void symbol(char c);
+    char symbol() const;
+
+    void relExp(Op op) { _kind = REL_OP; _op = op; }
+    std::string getRelOp() const;
+
+    bool isRelGT() const     { return _op == REL_GT;     } //done
+    bool isRelLT() const     { return _op == REL_LT;     } //done
+    bool isRelGTE() const    { return _op == REL_GTE;    } //done
+    bool isRelLTE() const    { return _op == REL_LTE;    } //done
+    bool isRelEQ() const     { return _op == REL_EQ;     } //done
+    bool isRelNotEQ() const  { return _op == REL_NOT_EQ; } //done
+    bool isRelEQML() const   { return _op == REL_EQML;   } //done
+    bool isRelAssign() const { return _op == ASSIGN;     }
+
+    bool isRelOp() const { return _kind == REL_OP; }
+
+    bool isCompOp() const { return _op >= REL_GT && _op <= REL_EQML; }
+
+    bool isColon()     const { return _op == COLON; }
+    bool isSemiColon() const { return _op == SEMICOLON; }
+    bool isAssignmentOperator() const     { return _op == ASSIGN; }
+    bool isMultiplicationOperator() const { return _op == MULTIPLY; }
+    bool isAdditionOperator() const       { return _op == ADD; }
+    bool isSubtractionOperator() const    { return _op == SUBTRACT; }
+    bool isModuloOperator() const         { return _op == MODULO; }
+    bool isDivisionOperator() const       { return _op == DIVIDE; }
+    bool isComma() const                  { return _op == COMMA; }
+    bool isArithmeticOperator() const     { return _op >= MULTIPLY && _op <= DIVIDE; }
+
+    bool isName() const                   { return _kind == NAME; }
+    std::string getName() const           { return std::string(getText()); }
+    Symbol getSymbol() const              { return _value.text.symbol; }
+    // `name` is the interned text of `s` (Symbols::intern).
+    void setName(Symbol s, std::string_view name) {
+        _kind = NAME;
+        setText(name);
+        _value.text.symbol = s;
     }
 
-    bool isPrint()  const { return _keyword == "print"; }
-    bool isFor()    const { return _keyword == "for";   }
-    bool isIf()     const { return _keyword == "if";    }
-    bool isElIf()   const { return _keyword == "elif";  }
-    bool isElse()   const { return _keyword == "else";  }
-    bool isIndent() const { return _keyword == "INDENT";}
-    bool isDedent() const { return _keyword == "DEDENT";}
-    bool isAnd()    const { return _keyword == "and";   }
-    bool isOr()     const { return _keyword == "or";    }
-    bool isNot()    const { return _keyword == "not";   }
-    bool isIn()     const { return _keyword == "in";    }
-    bool isRange()  const { return _keyword == "range"; }
-    bool isFunc()   const { return _keyword == "def";   }
-    bool isLen()    const { return _keyword == "len";   }
-    bool isPeriod() const { return _keyword == ".";     }
-    bool isReturn() const { return _keyword == "return";}
-
-    bool isFloat()  const  { return _isFloat; }
-    float getFloat() const { return _float; }
-    void setFloat(float f) {
-      _float = f;
-      _isFloat = true;
+    bool isKeyword() const { return _kind == KEYWORD; }
+
+    bool isString() const { return _kind == STRING; }
+
+    std::string getString() const { return std::string(getText()); }
+
+    void setString(std::string_view str) { _kind = STRING; setText(str); }
+
+    void setKeyword(Op keyword) { _kind = KEYWORD; _op = keyword; }
+
+    // The characters behind a NAME or STRING token. The token does not own
+    // them; names live in Symbols, strings in the Lexer that produced them.
+    std::string_view getText() const { return std::string_view(_value.text.ptr, _value.text.len); }
+
+    bool isPrint()  const { return _op == PRINT;  }
+    bool isFor()    const { return _op == FOR;    }
+    bool isIf()     const { return _op == IF;     }
+    bool isElIf()   const { return _op == ELIF;   }
+    bool isElse()   const { return _op == ELSE;   }
+    bool isIndent() const { return _op == INDENT; }
+    bool isDedent() const { return _op == DEDENT; }
+    bool isAnd()    const { return _op == AND;    }
+    bool isOr()     const { return _op == OR;     }
+    bool isNot()    const { return _op == NOT;    }
+    bool isIn()     const { return _op == IN;     }
+    bool isRange()  const { return _op == RANGE;  }
+    bool isFunc()   const { return _op == DEF;    }
+    bool isLen()    const { return _op == LEN;    }
+    bool isPeriod() const { return _op == PERIOD; }
+    bool isReturn() const { return _op == RETURN; }
+
+    bool isFloat()  const  { return _kind == FLOAT; }
+    double getFloat() const { return _value.floatValue; }
+    void setFloat(double f) {
+      _value.floatValue = f;
+      _kind = FLOAT;
     }
 
-    bool &isWholeNumber() { return _isWholeNumber; }
-    bool isWholeNumber() const { return _isWholeNumber; }
-    int getWholeNumber() const { return _wholeNumber; }
-    void setWholeNumber(int n) {
-        _wholeNumber = n;
-        isWholeNumber() = true;
+    bool isWholeNumber() const { return _kind == WHOLE_NUMBER; }
+    std::int64_t getWholeNumber() const { return _value.wholeNumber; }
+    void setWholeNumber(std::int64_t n) {
+        _value.wholeNumber = n;
+        _kind = WHOLE_NUMBER;
     }
 
     void print() const;
@@ -138,16 +154,24 @@ public:
     void dumpData() const;
 
 private:
-    std::string _name;
-    std::string _relExp;
-    std::string _keyword;
-    std::string _str;
-    bool _eof, _eol;
-    bool _isFloat;
-    bool _isWholeNumber;
-    char _symbol;
-    float _float;
-    int _wholeNumber;
+    void setText(std::string_view s) {
+        _value.text.ptr = s.data();
+        _value.text.len = static_cast<std::uint32_t>(s.size());
+    }
+
+    Kind _kind;
+    Op _op;
+    Span _span;
+
+    union {
+        std::int64_t wholeNumber;
+        double floatValue;
+        struct {
+            const char *ptr;
+            std::uint32_t len;
+            Symbol symbol;      // NAME only
+        } text;
+    } _value;
 };
 
 #endif //EXPRINTER_TOKEN_HPP
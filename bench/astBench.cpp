@@ -0,0 +1,134 @@
+// AST build and teardown benchmark on a large, expression-heavy program.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./astBench.x [blocks]
+//
+// The input is pre-tokenized outside the timed region. "parse" is
+// Parser::file_input building the tree into a fresh Arena; "teardown" is
+// dropping the tree, which with the Arena is freeing its blocks. A second
+// input of long arithmetic expressions times the expression parser alone.
+// Last, lexing and parsing the first input together, serially and with
+// ParallelParser (which only pays off with more than one core).
+
+#include <string>
+#include <memory>
+#include <algorithm>
+#include <thread>
+
+#include "bench.hpp"
+#include "../Arena.hpp"
+#include "../Parser.hpp"
+#include "../ParallelParser.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Source.hpp"
+#include "../lex/TokenStream.hpp"
+#include "../statements/Statement.hpp"
+
+static std::string expressionHeavyProgram(int blocks) {
+    std::string text = "total = 0\n";
+    for (int i = 0; i < blocks; i++) {
+        std::string n = std::to_string(i % 97);
+        text += "value = (" + n + " + total * 3 - 7) % 11 + " + n + " * (total - 1) / 5\n";
+        text += "if value > 3 and not value == 5 or total < " + n + ":\n";
+        text += "    total = total + value * 2 - (value % 3)\n";
+        text += "    label = \"item\"\n";
+        text += "else:\n";
+        text += "    for j in range(0, 3):\n";
+        text += "        total = total - 1\n";
+    }
+    return text;
+}
+
+static std::string longArithmeticProgram(int lines) {
+    static const char *ops[] = { " + ", " * ", " - ", " % ", " / " };
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        text += "value = ";
+        for (int t = 0; t < 40; t++) {
+            if (t > 0)
+                text += ops[(i + t) % 5];
+            text += (t % 7 == 3) ? "(total - " + std::to_string(t) + ")" : std::to_string(t + 1);
+        }
+        text += "\n";
+    }
+    return text;
+}
+
+static double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double parseBest(Source &source) {
+    double best = 1e300;
+    for (int rep = 0; rep < 5; rep++) {
+        Lexer lex(source);
+        TokenStream tokens(lex, true);
+        Arena arena;
+
+        auto start = std::chrono::steady_clock::now();
+        Parser parser(tokens, arena);
+        keep(parser.file_input().get());
+        best = std::min(best, msSince(start));
+    }
+    return best;
+}
+
+int main(int argc, char *argv[]) {
+
+    int blocks = argc > 1 ? std::stoi(argv[1]) : 50000;
+    auto source = Source::fromString(expressionHeavyProgram(blocks));
+
+    std::cout << "input: " << source->size() << " bytes" << std::endl;
+
+    double parse = 1e300, teardown = 1e300;
+    std::size_t arenaBytes = 0;
+
+    for (int rep = 0; rep < 5; rep++) {
+        Lexer lex(*source);
+        TokenStream tokens(lex, true);
+
+        auto arena = std::make_unique<Arena>();
+
+        auto start = std::chrono::steady_clock::now();
+        Parser parser(tokens, *arena);
+        auto stmts = parser.file_input();
+        keep(stmts.get());
+        parse = std::min(parse, msSince(start));
+
+        arenaBytes = arena->capacity();
+
+        start = std::chrono::steady_clock::now();
+        stmts.reset();
+        arena.reset();
+        teardown = std::min(teardown, msSince(start));
+    }
+
+    std::cout << "arena: " << arenaBytes / (1024 * 1024) << " MB" << std::endl;
+    report("parse", parse);
+    report("teardown", teardown);
+
+    auto arithmetic = Source::fromString(longArithmeticProgram(blocks));
+    std::cout << "long arithmetic input: " << arithmetic->size() << " bytes" << std::endl;
+    report("parse long arithmetic", parseBest(*arithmetic));
+
+    report("lex + parse, serial", timeBest(5, [&] {
+        Lexer lex(*source);
+        TokenStream tokens(lex, true);
+        Arena arena;
+        Parser parser(tokens, arena);
+        keep(parser.file_input().get());
+    }));
+
+    unsigned cores = std::thread::hardware_concurrency();
+    for (unsigned threads : { 2u, 4u, cores }) {
+        std::size_t chunks = 0;
+        double ms = timeBest(5, [&] {
+            ParallelParser parallel(*source, threads);
+            Arena arena;
+            keep(parallel.file_input(arena).get());
+            chunks = parallel.chunks();
+        });
+        report("lex + parse, " + std::to_string(threads) + " threads, " + std::to_string(chunks) + " chunks", ms);
+    }
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef __BENCH_HPP
+#define __BENCH_HPP
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+// Runs `body` `reps` times and reports the best wall-clock time in ms.
+template <class F>
+double timeBest(int reps, F body) {
+    double best = 1e300;
+    for (int i = 0; i < reps; i++) {
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto stop = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+        if (ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+inline void report(const std::string &what, double ms) {
+    std::cout << std::setw(40) << std::left << what << std::fixed << std::setprecision(2) << ms << " ms" << std::endl;
+}
+
+// Keeps the optimizer from discarding a result.
+template <class T>
+inline void keep(T const &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif
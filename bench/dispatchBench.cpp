@@ -0,0 +1,212 @@
+// Binary operator dispatch microbenchmark.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./dispatchBench.x [iterations]
+//
+// Times the same stream of int, double, bool and string operations three
+// ways: the way the Descriptor functions used to do it (heap descriptors,
+// a validTypeOp check, then dynamic_cast to reach the payload), through the
+// (lhs type, rhs type, op) kernel table on Values, and through the one
+// kernel the table holds for each operation, called directly. Then times a
+// tight arithmetic loop run by the interpreter, once dispatching every
+// operation through the table and once with its types inferred, so the
+// typed kernels run inline.
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "bench.hpp"
+#include "../Arena.hpp"
+#include "../Parser.hpp"
+#include "../Dispatch.hpp"
+#include "../DescriptorFunctions.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Source.hpp"
+#include "../lex/TokenStream.hpp"
+#include "../passes/Infer.hpp"
+#include "../passes/Resolve.hpp"
+#include "../statements/Statement.hpp"
+
+// The descriptors as they were: polymorphic, one heap object per value.
+namespace Legacy {
+
+    struct TypeDescriptor {
+        TypeDescriptor(int type): _type{type} {}
+        virtual ~TypeDescriptor() = default;
+        int _type;
+    };
+
+    struct NumberDescriptor: TypeDescriptor {
+        NumberDescriptor(int type): TypeDescriptor(type) {}
+        union {
+            std::int64_t intValue;
+            double doubleValue;
+            std::int64_t boolValue;
+        } _value;
+    };
+
+    struct StringDescriptor: TypeDescriptor {
+        StringDescriptor(): TypeDescriptor(::TypeDescriptor::STRING) {}
+        std::string _stringValue;
+    };
+
+    std::unique_ptr<TypeDescriptor> makeNumber(const Value &v) {
+        auto desc = std::make_unique<NumberDescriptor>(v.type());
+        desc->_value.intValue = v._value.intValue;
+        return desc;
+    }
+
+    std::unique_ptr<TypeDescriptor> make(const Value &v) {
+        if ( v.type() != ::TypeDescriptor::STRING )
+            return makeNumber(v);
+        auto desc = std::make_unique<StringDescriptor>();
+        desc->_stringValue = v._value.stringValue->_stringValue;
+        return desc;
+    }
+
+    std::unique_ptr<TypeDescriptor> createInt(std::int64_t value) {
+        auto desc = std::make_unique<NumberDescriptor>(::TypeDescriptor::INTEGER);
+        desc->_value.intValue = value;
+        return desc;
+    }
+
+    std::unique_ptr<TypeDescriptor> createBool(bool value) {
+        auto desc = std::make_unique<NumberDescriptor>(::TypeDescriptor::BOOL);
+        desc->_value.boolValue = value;
+        return desc;
+    }
+
+    std::unique_ptr<TypeDescriptor> binary(TypeDescriptor *lhs, TypeDescriptor *rhs, const Token *t) {
+
+        if ( !Descriptor::validTypeOp(lhs->_type, rhs->_type) )
+            exit(1);
+
+        if ( t->isRelOp() ) {
+            if ( lhs->_type == ::TypeDescriptor::STRING ) {
+                auto l = dynamic_cast<StringDescriptor *>(lhs);
+                auto r = dynamic_cast<StringDescriptor *>(rhs);
+                return createBool(l->_stringValue < r->_stringValue);
+            }
+            auto l = dynamic_cast<NumberDescriptor *>(lhs);
+            auto r = dynamic_cast<NumberDescriptor *>(rhs);
+            double lhsVar, rhsVar;
+            lhsVar = l->_type == ::TypeDescriptor::DOUBLE ? l->_value.doubleValue : (double) l->_value.intValue;
+            rhsVar = r->_type == ::TypeDescriptor::DOUBLE ? r->_value.doubleValue : (double) r->_value.intValue;
+            return createBool(lhsVar < rhsVar);
+        }
+
+        if ( lhs->_type == ::TypeDescriptor::STRING && rhs->_type == ::TypeDescriptor::STRING ) {
+            auto desc = std::make_unique<StringDescriptor>();
+            desc->_stringValue = dynamic_cast<StringDescriptor *>(lhs)->_stringValue +
+                                 dynamic_cast<StringDescriptor *>(rhs)->_stringValue;
+            return desc;
+        }
+
+        auto l = dynamic_cast<NumberDescriptor *>(lhs);
+        auto r = dynamic_cast<NumberDescriptor *>(rhs);
+        if ( lhs->_type == ::TypeDescriptor::DOUBLE && rhs->_type == ::TypeDescriptor::DOUBLE ) {
+            auto desc = std::make_unique<NumberDescriptor>(::TypeDescriptor::DOUBLE);
+            desc->_value.doubleValue = l->_value.doubleValue + r->_value.doubleValue;
+            return desc;
+        }
+        if ( t->isAdditionOperator() )
+            return createInt(l->_value.intValue + r->_value.intValue);
+        return createInt(l->_value.intValue * r->_value.intValue);
+    }
+};
+
+struct Operation {
+    Value lhs, rhs;
+    Token op;
+};
+
+static std::vector<Operation> operations() {
+    Token add(Token::SYMBOL, Token::ADD), multiply(Token::SYMBOL, Token::MULTIPLY), less(Token::REL_OP, Token::REL_LT);
+
+    std::vector<Operation> ops;
+    for (int i = 0; i < 64; i++) {
+        Value n = Descriptor::Int::createIntDescriptor(i * 7 % 13);
+        Value d = Descriptor::Double::createDoubleDescriptor(i * 0.5);
+        Value b = Descriptor::Bool::createBooleanDescriptor(i % 2);
+
+        ops.push_back({n, Descriptor::Int::createIntDescriptor(i), i % 3 ? add : multiply});
+        ops.push_back({n, Descriptor::Int::createIntDescriptor(3), less});
+        ops.push_back({d, d, add});
+        ops.push_back({d, n, less});
+        ops.push_back({b, n, less});
+        if ( i % 8 == 0 )
+            ops.push_back({Descriptor::String::createStringDescriptor(std::string("ab")),
+                           Descriptor::String::createStringDescriptor(std::string("cd")), i % 16 ? less : add});
+    }
+    return ops;
+}
+
+static const char *loopProgram =
+    "x = 0\n"
+    "y = 1\n"
+    "for i in range(200000):\n"
+    "    x = x + i * 3 % 7 - y\n"
+    "    if x > 1000 and i > 10:\n"
+    "        x = x - 1000\n"
+    "print x\n";
+
+int main(int argc, char *argv[]) {
+
+    int iterations = argc > 1 ? std::stoi(argv[1]) : 20000;
+    auto ops = operations();
+
+    // What the old evaluator held: one descriptor per operand.
+    std::vector<std::pair<std::unique_ptr<Legacy::TypeDescriptor>, std::unique_ptr<Legacy::TypeDescriptor>>> legacy;
+    for (auto &&op : ops)
+        legacy.emplace_back(Legacy::make(op.lhs), Legacy::make(op.rhs));
+
+    std::cout << ops.size() << " operations x " << iterations << std::endl;
+
+    report("heap descriptors + dynamic_cast", timeBest(5, [&] {
+        for (int n = 0; n < iterations; n++)
+            for (std::size_t i = 0; i < ops.size(); i++)
+                keep(Legacy::binary(legacy[i].first.get(), legacy[i].second.get(), &ops[i].op));
+    }));
+
+    report("Values + kernel table", timeBest(5, [&] {
+        for (int n = 0; n < iterations; n++)
+            for (auto &&op : ops)
+                keep(Descriptor::binary(op.lhs, op.rhs, &op.op));
+    }));
+
+    std::vector<Descriptor::Kernel> kernels;
+    for (auto &&op : ops)
+        kernels.push_back(Descriptor::kernelFor(op.lhs.type(), op.rhs.type(), op.op.op()));
+
+    report("Values + kernel chosen once", timeBest(5, [&] {
+        for (int n = 0; n < iterations; n++)
+            for (std::size_t i = 0; i < ops.size(); i++)
+                keep(kernels[i](ops[i].lhs, ops[i].rhs, &ops[i].op));
+    }));
+
+    auto source = Source::fromString(loopProgram);
+    Lexer lex(*source);
+    TokenStream tokens(lex, true);
+    Arena arena;
+    Parser parser(tokens, arena);
+    auto stmts = parser.file_input();
+
+    std::cout << std::endl << "interpreted loop, 200000 iterations" << std::endl;
+
+    SymTab symTab;
+    Passes::resolveSlots(*stmts, symTab);
+
+    std::streambuf *out = std::cout.rdbuf(nullptr);
+    double untyped = timeBest(5, [&] { stmts->evaluate(symTab); });
+
+    Passes::TypeEnv types;
+    int typed = Passes::inferTypes(*stmts, types);
+    double inferred = timeBest(5, [&] { stmts->evaluate(symTab); });
+    std::cout.rdbuf(out);
+
+    report("every operation through the table", untyped);
+    report("types inferred (" + std::to_string(typed) + " nodes)", inferred);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+// Expression evaluation benchmark: ExprNode trees against the FlatTree layout.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./flatBench.x [lines]
+//
+// Parses a program of long arithmetic / comparison / boolean assignments,
+// runs it once so every variable is defined, then times evaluating all of
+// its expressions, first by walking the trees and then from a FlatTree
+// built from the same trees. Only evaluation is timed.
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "bench.hpp"
+#include "../Arena.hpp"
+#include "../Parser.hpp"
+#include "../FlatExpr.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Source.hpp"
+#include "../lex/TokenStream.hpp"
+#include "../statements/Statement.hpp"
+
+static std::string expressionHeavyProgram(int lines) {
+    std::string text = "a = 3\nb = 7\n";
+    for (int i = 0; i < lines; i++) {
+        std::string n = std::to_string(i % 89 + 1);
+        if (i % 3 == 2)
+            text += "t = a * " + n + " > b - 4 and a < " + n + " or not a % 5 == b % 3\n";
+        else
+            text += "v = ((a + " + n + ") * (b - 2) - a * a % 7 + " + n + ") * b - (b * " + n + " - a) / 3\n";
+    }
+    return text;
+}
+
+int main(int argc, char *argv[]) {
+
+    int lines = argc > 1 ? std::stoi(argv[1]) : 100000;
+    auto source = Source::fromString(expressionHeavyProgram(lines));
+
+    Lexer lex(*source);
+    TokenStream tokens(lex, true);
+    Arena arena;
+    Parser parser(tokens, arena);
+    auto stmts = parser.file_input();
+
+    SymTab symTab;
+    stmts->evaluate(symTab);
+
+    std::vector<ExprNode *> exprs;
+    stmts->visitExprs([&](ArenaPtr<ExprNode> &slot) { exprs.push_back(slot.get()); });
+
+    FlatTree tree;
+    std::vector<FlatTree::Index> roots;
+    for (auto expr : exprs)
+        roots.push_back(tree.flatten(expr));
+
+    std::cout << "input: " << source->size() << " bytes, " << exprs.size() << " expressions, "
+              << tree.size() << " flat nodes" << std::endl;
+
+    report("evaluate ExprNode trees", timeBest(5, [&] {
+        for (auto expr : exprs)
+            keep(expr->evaluate(symTab));
+    }));
+
+    report("evaluate FlatTree", timeBest(5, [&] {
+        for (auto root : roots)
+            keep(tree.evaluate(root, symTab));
+    }));
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+// Lexer microbenchmark on identifier-heavy input.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./lexBench.x [lines]
+//
+// Times keyword classification of every identifier in the input with the
+// old chain of std::string compares against the Keywords perfect hash, then
+// times a full Lexer pass over the same text, token by token and pre-tokenized.
+// Finally compares the Scan kernels on deeply nested input.
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "bench.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Keywords.hpp"
+#include "../lex/Source.hpp"
+#include "../lex/Scan.hpp"
+
+// The classifier the lexer used before lex/Keywords.hpp.
+static bool isKeywordChain(std::string s) {
+    return (s == "for" || s == "print" || s == "if" || s == "else" || s == "elif" ||
+            s == "def" || s == "and" || s == "or" || s == "while" || s == "not" || s == "in" ||
+            s == "range" || s == "len" || s == "def" );
+}
+
+static std::string identifierHeavyProgram(int lines) {
+    static const char *names[] = {
+        "total", "index", "left_value", "right_value", "elapsed", "counter",
+        "in_range", "printer", "format", "if_flag", "orbit", "notes", "defaults",
+        "length", "elsewhere", "whilst", "x", "y", "z", "accumulator"
+    };
+    const int n = sizeof(names) / sizeof(names[0]);
+
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        const char *a = names[i % n], *b = names[(i * 7 + 3) % n], *c = names[(i * 13 + 5) % n];
+        if (i % 4 == 0)
+            text += std::string("if ") + a + " and " + b + " or not " + c + ":\n    print " + a + "\n";
+        else
+            text += std::string(a) + " = " + b + " + " + c + " * " + a + "_" + std::to_string(i % 100) + "\n";
+    }
+    return text;
+}
+
+// Nested for-loops in the style of tests/testNestedForLoop_3.txt: most of
+// the bytes are leading indentation.
+static std::string deeplyNestedProgram(int blocks, int depth) {
+    std::string text;
+    for (int b = 0; b < blocks; b++) {
+        for (int d = 0; d < depth; d++)
+            text += std::string(4 * d, ' ') + "for loop_variable_" + std::to_string(d) + " in range(1):\n";
+        text += std::string(4 * depth, ' ') + "accumulated_total = accumulated_total + 1\n";
+    }
+    return text;
+}
+
+static void scanLines(const Scan::Kernels &k, const Source &src) {
+    long total = 0;
+    int tabs = 0;
+    for (const char *p = src.begin(); p < src.end(); ) {
+        const char *q = k.skipBlanks(p, src.end(), tabs);
+        q = k.skipIdentifier(q, src.end());
+        total += q - p;
+        p = k.findNewline(q, src.end()) + 1;
+    }
+    keep(total);
+}
+
+int main(int argc, char *argv[]) {
+
+    int lines = argc > 1 ? std::stoi(argv[1]) : 200000;
+    auto source = Source::fromString(identifierHeavyProgram(lines));
+
+    // Collect the raw identifier/keyword words once so the classifier
+    // comparison measures nothing but classification.
+    std::vector<std::string_view> words;
+    for (const char *p = source->begin(); p < source->end(); ) {
+        if (isalpha(*p) || *p == '_') {
+            const char *start = p;
+            while (p < source->end() && (isalnum(*p) || *p == '_'))
+                p++;
+            words.emplace_back(start, p - start);
+        } else {
+            p++;
+        }
+    }
+
+    std::cout << "input: " << source->size() << " bytes, " << words.size() << " identifiers/keywords" << std::endl;
+
+    report("keyword chain of string compares", timeBest(5, [&] {
+        int hits = 0;
+        for (auto &&w : words)
+            hits += isKeywordChain(std::string(w));
+        keep(hits);
+    }));
+
+    report("keyword perfect hash", timeBest(5, [&] {
+        int hits = 0;
+        for (auto &&w : words)
+            hits += Keywords::lookup(w) != Token::NO_OP;
+        keep(hits);
+    }));
+
+    report("full Lexer pass", timeBest(5, [&] {
+        Lexer lex(*source);
+        long count = 0;
+        while (!lex.getToken().eof())
+            count++;
+        keep(count);
+    }));
+
+    report("Lexer::tokenize into one vector", timeBest(5, [&] {
+        Lexer lex(*source);
+        keep(lex.tokenize().size());
+    }));
+
+    auto nested = Source::fromString(deeplyNestedProgram(lines / 20, 20));
+    std::cout << "nested input: " << nested->size() << " bytes, selected kernels: " << Scan::kernels.name << std::endl;
+
+    report("scan kernels: scalar", timeBest(5, [&] { scanLines(Scan::scalarKernels, *nested); }));
+#if defined(__x86_64__) || defined(__i386__)
+    report("scan kernels: sse2", timeBest(5, [&] { scanLines(Scan::sse2Kernels, *nested); }));
+    report("scan kernels: avx2", timeBest(5, [&] { scanLines(Scan::avx2Kernels, *nested); }));
+#endif
+
+    report("full Lexer pass, nested input", timeBest(5, [&] {
+        Lexer lex(*nested);
+        long count = 0;
+        while (!lex.getToken().eof())
+            count++;
+        keep(count);
+    }));
+
+    return 0;
+}
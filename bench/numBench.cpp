@@ -0,0 +1,88 @@
+// Numeric literal microbenchmark.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./numBench.x [lines]
+//
+// Times conversion of every numeric literal in a numbers-only program the
+// way Lexer::readNumber used to do it (copy into a std::string, then
+// stoi/atof) against std::from_chars straight off the source, then times a
+// full Lexer pass over the same text.
+
+#include <string>
+#include <vector>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+
+#include "bench.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Source.hpp"
+
+static std::string numericHeavyProgram(int lines) {
+    std::string text;
+    for (int i = 0; i < lines; i++) {
+        long a = (i * 7919L) % 1000003, b = (i * 104729L) % 99991;
+        text += "value_" + std::to_string(i % 10) + " = " + std::to_string(a) + " + " + std::to_string(b) +
+                " * " + std::to_string(a % 1000) + "." + std::to_string(b % 1000) + "\n";
+    }
+    return text;
+}
+
+int main(int argc, char *argv[]) {
+
+    int lines = argc > 1 ? std::stoi(argv[1]) : 200000;
+    auto source = Source::fromString(numericHeavyProgram(lines));
+
+    // Collect the literals once so the conversion comparison measures
+    // nothing but conversion.
+    std::vector<std::string_view> literals;
+    for (const char *p = source->begin(); p < source->end(); ) {
+        if (isdigit(*p) && (p == source->begin() || p[-1] == ' ')) {
+            const char *start = p;
+            while (p < source->end() && (isdigit(*p) || *p == '.'))
+                p++;
+            literals.emplace_back(start, p - start);
+        } else {
+            p++;
+        }
+    }
+
+    std::cout << "input: " << source->size() << " bytes, " << literals.size() << " numeric literals" << std::endl;
+
+    report("std::string + stoi/atof", timeBest(5, [&] {
+        double sum = 0;
+        for (auto &&lit : literals) {
+            std::string number(lit);
+            if (number.find('.') != std::string::npos)
+                sum += atof(number.c_str());
+            else
+                sum += stoi(number);
+        }
+        keep(sum);
+    }));
+
+    report("std::from_chars in place", timeBest(5, [&] {
+        double sum = 0;
+        for (auto &&lit : literals) {
+            if (lit.find('.') != std::string_view::npos) {
+                double d;
+                std::from_chars(lit.data(), lit.data() + lit.size(), d);
+                sum += d;
+            } else {
+                std::int64_t n;
+                std::from_chars(lit.data(), lit.data() + lit.size(), n);
+                sum += n;
+            }
+        }
+        keep(sum);
+    }));
+
+    report("full Lexer pass", timeBest(5, [&] {
+        Lexer lex(*source);
+        long count = 0;
+        while (!lex.getToken().eof())
+            count++;
+        keep(count);
+    }));
+
+    return 0;
+}
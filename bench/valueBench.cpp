@@ -0,0 +1,94 @@
+// String Value benchmark.
+//
+//   make -C .. CFLAGS="-O2 -std=c++17" && make && ./valueBench.x [copies] [reads]
+//
+// Copies and drops a string Value over and over, the way assignments and
+// variable reads do: with its descriptor counted with plain loads and
+// stores (the default), counted atomically after Value::share(), and
+// deep-copied into a fresh StringDescriptor the way Values were copied
+// before strings were reference counted.
+//
+// Then runs a program that builds a 1 MB string and reads, assigns and
+// compares it in a loop. With copy-on-write none of that copies its
+// bytes; the last line times one deep copy of it per iteration, which is
+// what every read of it used to cost.
+
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "../Arena.hpp"
+#include "../Parser.hpp"
+#include "../Descriptor.hpp"
+#include "../DescriptorFunctions.hpp"
+#include "../lex/Lexer.hpp"
+#include "../lex/Source.hpp"
+#include "../lex/TokenStream.hpp"
+#include "../passes/Infer.hpp"
+#include "../passes/Resolve.hpp"
+#include "../statements/Statement.hpp"
+
+static std::string readLoopProgram(int reads) {
+    return "s = \"x\"\n"
+           "for i in range(20):\n"
+           "    s = s + s\n"
+           "n = 0\n"
+           "for i in range(" + std::to_string(reads) + "):\n"
+           "    t = s\n"
+           "    if t == s and s > \"w\":\n"
+           "        n = n + 1\n"
+           "print n\n";
+}
+
+int main(int argc, char *argv[]) {
+
+    int copies = argc > 1 ? std::stoi(argv[1]) : 10000000;
+    int reads = argc > 2 ? std::stoi(argv[2]) : 1000;
+
+    Value text = Descriptor::String::createStringDescriptor(std::string("a string too long for SSO"));
+
+    std::cout << copies << " copies of a " << text._value.stringValue->_stringValue.size() << "-character string" << std::endl;
+
+    report("deep copy", timeBest(5, [&] {
+        for (int i = 0; i < copies; i++)
+            keep(Descriptor::String::createStringDescriptor(text._value.stringValue->_stringValue));
+    }));
+
+    report("shared, non-atomic count", timeBest(5, [&] {
+        for (int i = 0; i < copies; i++)
+            keep(Value(text));
+    }));
+
+    text.share();
+    report("shared, atomic count", timeBest(5, [&] {
+        for (int i = 0; i < copies; i++)
+            keep(Value(text));
+    }));
+
+    auto source = Source::fromString(readLoopProgram(reads));
+    Lexer lex(*source);
+    TokenStream tokens(lex, true);
+    Arena arena;
+    Parser parser(tokens, arena);
+    auto stmts = parser.file_input();
+
+    SymTab symTab;
+    Passes::TypeEnv types;
+    Passes::resolveSlots(*stmts, symTab);
+    Passes::inferTypes(*stmts, types);
+
+    std::cout << std::endl << "1 MB string variable, " << reads << " iterations" << std::endl;
+
+    std::streambuf *out = std::cout.rdbuf(nullptr);
+    double loop = timeBest(5, [&] { stmts->evaluate(symTab); });
+    std::cout.rdbuf(out);
+    report("interpreted read loop", loop);
+
+    std::string megabyte(1 << 20, 'x');
+    report("one deep copy per iteration", timeBest(5, [&] {
+        for (int i = 0; i < reads; i++)
+            keep(Descriptor::String::createStringDescriptor(megabyte));
+    }));
+
+    return 0;
+}
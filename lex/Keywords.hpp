@@ -0,0 +1,75 @@
+#ifndef __KEYWORDS_HPP
+#define __KEYWORDS_HPP
+
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#include "../Token.hpp"
+
+// Perfect hash from identifier text to keyword. The hash only looks at the
+// first byte, the last byte and the length, so classifying an identifier is
+// one table probe plus one memcmp against the single candidate.
+namespace Keywords {
+
+    struct Entry {
+        const char *text;
+        std::size_t length;
+        Token::Op op;
+    };
+
+    constexpr Entry keywords[] = {
+        { "for",   3, Token::FOR   },
+        { "print", 5, Token::PRINT },
+        { "if",    2, Token::IF    },
+        { "else",  4, Token::ELSE  },
+        { "elif",  4, Token::ELIF  },
+        { "def",   3, Token::DEF   },
+        { "and",   3, Token::AND   },
+        { "or",    2, Token::OR    },
+        { "while", 5, Token::WHILE },
+        { "not",   3, Token::NOT   },
+        { "in",    2, Token::IN    },
+        { "range", 5, Token::RANGE },
+        { "len",   3, Token::LEN   },
+    };
+
+    constexpr std::size_t tableSize = 32;
+
+    constexpr std::size_t hash(const char *s, std::size_t length) {
+        return ( (unsigned char) s[0] + (unsigned char) s[length - 1] + length ) & (tableSize - 1);
+    }
+
+    constexpr std::array<Entry, tableSize> buildTable() {
+        std::array<Entry, tableSize> table{};
+        for (auto &&kw : keywords)
+            table[hash(kw.text, kw.length)] = kw;
+        return table;
+    }
+
+    constexpr bool isPerfect() {
+        for (std::size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++)
+            for (std::size_t j = i + 1; j < sizeof(keywords) / sizeof(keywords[0]); j++)
+                if (hash(keywords[i].text, keywords[i].length) == hash(keywords[j].text, keywords[j].length))
+                    return false;
+        return true;
+    }
+
+    static_assert(isPerfect(), "Keyword hash has a collision -- pick a new hash() when adding keywords");
+
+    constexpr std::array<Entry, tableSize> table = buildTable();
+
+    // Returns Token::NO_OP if `s` isn't a keyword.
+    inline Token::Op lookup(std::string_view s) {
+        if (s.empty())
+            return Token::NO_OP;
+
+        const Entry &e = table[hash(s.data(), s.size())];
+        if (e.length == s.size() && std::memcmp(e.text, s.data(), s.size()) == 0)
+            return e.op;
+
+        return Token::NO_OP;
+    }
+};
+
+#endif
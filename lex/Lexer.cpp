@@ -1,90 +1,107 @@
 #include <iostream>
 #include <string>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
 
 #include "Lexer.hpp"
-
-Lexer::Lexer(std::ifstream &stream):
-    inStream{stream},
-    ungottenToken{false},
+#include "Keywords.hpp"
+#include "Scan.hpp"
+
+Lexer::Lexer(Source &source):
+    pythonLexSpace({0}),
+    _pendingCount{0},
+    _generation{0},
+    _source{source},
+    _cur{source.begin()},
+    _end{source.end()},
+    _lineStart{source.begin()},
+    _line{1},
     tokIdx{0},
     startLine{true},
     _numTabs{0},
-    _numSpace{0},
-    pythonLexSpace({0})
+    _numSpace{0}
 {}
 
-static inline bool isEqualityOperator(char c) { return c == '=' || c == '!' || c == '<' || c == '>'; };
-static inline bool isKeyword(std::string s) {
-    return (s == "for" || s == "print" || s == "if" || s == "else" || s == "elif" ||
-            s == "def" || s == "and" || s == "or" || s == "while" || s == "not" || s == "in" ||
-            s == "range" || s == "len" || s == "def" );
+Lexer::Lexer(Source &source, const char *begin, const char *end, std::uint32_t line):
+    Lexer(source)
+{
+    _cur = begin;
+    _end = end;
+    _lineStart = begin;
+    _line = line;
 }
 
+thread_local bool Lexer::abandonOnError = false;
+
+void Lexer::fatal(const std::string &message) {
+    if (abandonOnError)
+        throw ParseAbandoned{};
+    std::cout << message;
+    exit(1);
+}
+
+static inline bool isEqualityOperator(char c) { return c == '=' || c == '!' || c == '<' || c == '>'; };
 inline int Lexer::spacesConsumedOnLine() {
     return _numTabs + _numSpace;
 }
 
-std::string Lexer::readEqualityOperator() {
+Token::Op Lexer::readEqualityOperator() {
 
-    char c;
-    inStream.get(c);
+    char c = *_cur++;
 
     if ( c == '=' ) {
-        inStream.get(c);
+        c = peek();
 
         if (c == '>' || c == '<') {
-            std::cout << "Invalid RelOP -> " << c << " <- found... exiting. \n";
-            exit(1);
+            fatal(std::string("Invalid RelOP -> ") + c + " <- found... exiting. \n");
         } else if (c == '=') {
-            return "==";
+            _cur++;
+            return Token::REL_EQ;
         } else {
-            inStream.putback(c);
-            return "=";
+            return Token::ASSIGN;
         }
     } else if ( c == '>' ) {
-        inStream.get(c);
+        c = peek();
 
         if ( c == '=' ) {    //relGTE
-            return ">=";
+            _cur++;
+            return Token::REL_GTE;
         } else {            //GT
-            inStream.putback(c);
-            return ">";
+            return Token::REL_GT;
         }
     } else if ( c == '<' ) {
-        inStream.get(c);
+        c = peek();
 
         if (c == '=') { // LTE
-            return "<=";
+            _cur++;
+            return Token::REL_LTE;
         } else if (c == '>') {//ML NEQ
-            return "<>";
+            _cur++;
+            return Token::REL_EQML;
         } else { // LT
-            inStream.putback(c);
-            return "<";
+            return Token::REL_LT;
         }
     } else if ( c == '!' ) {
-        inStream.get(c);
+        c = peek();
 
         if (c == '=') {
-            return "!=";
+            _cur++;
+            return Token::REL_NOT_EQ;
         } else {
-            std::cout << "Invalid RelOP -> " << c << " <- found.. exiting. \n";
-            exit(1);
+            fatal(std::string("Invalid RelOP -> ") + c + " <- found.. exiting. \n");
         }
     }
 
-    std::cout << "Fatal Error Lexer::readEqualityOperator\n";
-    std::cout << "Dump ->" << c << "<-" << std::endl;
-    exit(1);
-
-    return "";
+    fatal(std::string("Fatal Error Lexer::readEqualityOperator\nDump ->") + c + "<-\n");
 }
 
-std::string Lexer::readString() {
+// Returns a slice of the source when the literal has no escapes; otherwise
+// the decoded text, kept in the string pool.
+std::string_view Lexer::readString(std::uint32_t &newlines, std::size_t &lineOffset) {
 
-    char c;
-    inStream.get(c);
+    char c = *_cur++;
 
-    std::string capture = "";
     char escapeOn = '\0';
 
     if (c == '"')
@@ -93,47 +110,102 @@ std::string Lexer::readString() {
         escapeOn = '\'';
 
     if (escapeOn == '\0') {
-        std::cout << "Fatal Error Lexer::readString.. expected {\",'} got ->" << escapeOn << "<-\n";
-        exit(1); 
+        fatal(std::string("Fatal Error Lexer::readString.. expected {\",'} got ->") + escapeOn + "<-\n");
     }
 
-    inStream.get(c);
-    // keep it simple to continue 
-    // TODO come back later and deal with escape
-    while (c != escapeOn/* && seenEscape == false*/) {
-        capture += c;
-        inStream.get(c);
+    const char *start = _cur;
+    bool seenEscape = false;
+    newlines = 0;
+
+    while (true) {
+        // A streamed literal can run past the window (escaped newlines);
+        // keep the next two bytes in view so an escape is never split.
+        if (_end - _cur < 2 && !_source.exhausted()) {
+            std::size_t startAt = start - _lineStart;
+            refill();
+            start = _lineStart + startAt;
+            continue;
+        }
+        if (_cur >= _end || *_cur == escapeOn)
+            break;
+
+        if (*_cur == '\\') {
+            seenEscape = true;
+            _cur++;
+        }
+        if (_cur < _end && *_cur == '\n') {
+            newlines++;
+            lineOffset = _cur + 1 - _lineStart;
+        }
+        _cur++;
     }
 
-    return capture;
+    if (_cur >= _end) {
+        fatal("Fatal Error Lexer::readString.. unterminated string literal\n");
+    }
+
+    std::string_view raw(start, _cur - start);
+    _cur++;     // closing quote
+
+    return seenEscape ? keep(decodeEscapes(raw)) : stable(raw);
+}
+
+// Python 2 escape sequences. Unknown escapes are kept as written, backslash
+// included, as Python does.
+std::string Lexer::decodeEscapes(std::string_view raw) {
+
+    std::string decoded;
+    decoded.reserve(raw.size());
+
+    for (std::size_t i = 0; i < raw.size(); i++) {
+        if (raw[i] != '\\' || i + 1 == raw.size()) {
+            decoded += raw[i];
+            continue;
+        }
+
+        char c = raw[++i];
+        switch (c) {
+            case 'n':  decoded += '\n'; break;
+            case 't':  decoded += '\t'; break;
+            case 'r':  decoded += '\r'; break;
+            case 'a':  decoded += '\a'; break;
+            case 'b':  decoded += '\b'; break;
+            case 'f':  decoded += '\f'; break;
+            case 'v':  decoded += '\v'; break;
+            case '0':  decoded += '\0'; break;
+            case '\\': decoded += '\\'; break;
+            case '\'': decoded += '\''; break;
+            case '"':  decoded += '"';  break;
+            case '\n': break;      // line continuation
+            default:
+                decoded += '\\';
+                decoded += c;
+        }
+    }
+
+    return decoded;
 }
 
 void Lexer::consumeLine() {
     
-    char c;
-    inStream.get(c);
+    char c = *_cur++;
 
     if (c != '#') {
-        std::cout << "Fatal Error Lexer::consumeLine.. expected #, got " << c << "\n";
-        exit(1);
+        fatal(std::string("Fatal Error Lexer::consumeLine.. expected #, got ") + c + "\n");
     }
 
-    while (c != '\n') {
-            if (inStream.eof()) {
-            auto tok = std::make_shared<Token>();
-            tok->eof() = true;
-            _tokens.push(tok);
-            return;
-        }
+    _cur = Scan::findNewline(_cur, _end);
 
-        inStream.get(c);
+    if (atEnd()) {
+        queue(Token(Token::END_OF_FILE, Token::NO_OP));
+        return;
     }
 
-    if ( startLine == false ) {
-        auto token = std::make_shared<Token>();
-        token->eol() = true;
-        _tokens.push(token);
-    }
+    if ( startLine == false )
+        queue(Token(Token::END_OF_LINE, Token::NO_OP));
+
+    _cur++;     // the newline
+    newLine();
 
     startLine = true;
     _numTabs = 0;
@@ -148,29 +220,35 @@ bool Lexer::consumeLeadingSpaces() {
         return false;
     }
 
-    char c;
-    inStream.get(c);
+    while (_cur < _end) {
+        const char *blanksStart = _cur;
+        int tabs = 0;
 
-    while (isspace(c)) {
-        if (c == '\t') 
-            _numTabs += 1;
-        else if (c == ' ') {
-            _numSpace += 1;
-        }
-        else if (c == '\n') {
+        _cur = Scan::skipBlanks(_cur, _end, tabs);
+        _numTabs += tabs;
+        _numSpace += (_cur - blanksStart) - tabs;
+
+        if (_cur == _end || !isspace(*_cur))
+            break;
+
+        char c = *_cur++;
+        if (c == '\n') {
+            newLine();
             startLine = true;
             _numTabs = 0;
             _numSpace = 0;
             return true;
         }
-
-        inStream.get(c);
     }
 
-    if (inStream.good())
-        inStream.putback(c);
+    // Trailing blanks at end of input don't open a new block.
+    if (atEnd()) {
+        _numTabs = 0;
+        _numSpace = 0;
+        return false;
+    }
 
-    if ( c == '#' ) {
+    if ( *_cur == '#' ) {
         consumeLine();
         return true;
     }
@@ -180,88 +258,107 @@ bool Lexer::consumeLeadingSpaces() {
 }
 
 //https://stackoverflow.com/questions/31171075/what-is-the-best-practice-when-passing-a-shared-pointer-to-a-non-owning-function
-void Lexer::readNumber(const bool isNegative, const std::shared_ptr<Token>& tok) {
-    // int intValue = 0;
-    char c;
-    std::string number = "";
+// Parses the literal in place; nothing is copied out of the source.
+void Lexer::readNumber(const bool isNegative, Token &tok) {
+    const char *start = _cur;
     bool isFloat = false;
-    while( inStream.get(c) && isdigit(c) ) {
-        // intValue = intValue * 10 + c - '0';
-        number += c;
-    }
-    if (c == '.') {
-        number += c;
+    while( _cur < _end && isdigit(*_cur) )
+        _cur++;
+    if (peek() == '.') {
+        _cur++;
         isFloat = true;
-        while( inStream.get(c) && isdigit(c) ) {
-        // intValue = intValue * 10 + c - '0';
-            number += c;
-        }
+        while( _cur < _end && isdigit(*_cur) )
+            _cur++;
     }
-    if (inStream.good())
-        inStream.putback(c);
 
-    if ( number == "." ) {
-        tok->setKeyword(".");
+    if ( _cur - start == 1 && *start == '.' ) {
+        tok.setKeyword(Token::PERIOD);
     }
 
     else if ( isFloat ) {
-        float floatValue = atof(number.c_str());
+        double floatValue = 0.;
+        auto result = std::from_chars(start, _cur, floatValue);
+        if ( result.ec != std::errc() ) {
+            fatal("Fatal Error Lexer::readNumber.. float literal " + std::string(start, _cur - start) +
+                  " out of range on line " + std::to_string(_line) + "\n");
+        }
         if (isNegative)
             floatValue *= -1.;
-        tok->setFloat( floatValue );
+        tok.setFloat( floatValue );
     }
 
     else {
-        int intValue = stoi(number);
+        std::int64_t intValue = 0;
+        auto result = std::from_chars(start, _cur, intValue);
+        if ( result.ec != std::errc() ) {
+            fatal("Fatal Error Lexer::readNumber.. integer literal " + std::string(start, _cur - start) +
+                  " does not fit in 64 bits on line " + std::to_string(_line) + "\n");
+        }
         if (isNegative)
             intValue *= -1;
-        tok->setWholeNumber( intValue );
+        tok.setWholeNumber( intValue );
     }
 
-
 }
 
-std::string Lexer::readName() {
+std::string_view Lexer::readName() {
 
-    std::string name;
-    char c;
+    const char *start = _cur;
+    char c = *_cur++;
 
-    inStream.get(c);
-
-    if ( c == '_' || isalnum(c) ) {
-      name += c;
-    } else {
-      exit(1);
+    if ( !( c == '_' || isalnum(c) ) ) {
+      fatal("");
     }
 
-    while ( inStream.get(c) && ( c == '_' || isalnum(c) || isdigit(c) )) {
-      name += c;
-    }
+    _cur = Scan::skipIdentifier(_cur, _end);
 
-    if(inStream.good())  // In the loop, we have read one char too many.
-        inStream.putback(c);
-    return name;
+    return std::string_view(start, _cur - start);
 }
 
 
-auto Lexer::getToken() -> std::shared_ptr<Token> {
+Span Lexer::spanFrom(const char *start) const {
+    const std::size_t column = start - _lineStart + 1;
+    const std::size_t length = _cur - start;
+    return Span{
+        static_cast<std::uint32_t>(_source.offsetOf(start)),
+        _line,
+        static_cast<std::uint16_t>(column < UINT16_MAX ? column : UINT16_MAX),
+        static_cast<std::uint16_t>(length < UINT16_MAX ? length : UINT16_MAX)
+    };
+}
 
-    if (ungottenToken) {
-        ungottenToken = false;
-        return lastToken;
-    }
+void Lexer::queue(Token tok) {
+    tok.setSpan(spanFrom(_cur));
+    _pending = tok;
+    _pendingCount++;
+}
 
-    if (!_tokens.empty()) {
-        if (debug)
-            std::cout << "!_tokens.empty()" << std::endl;
-        auto cachedToken = _tokens.front();
-        _processedTokens.push_back(cachedToken);
-        _tokens.pop();
-        return lastToken = cachedToken;
+std::vector<Token> Lexer::tokenize() {
+
+    // Roughly one token per four bytes of source; good enough that the
+    // vector seldom has to grow.
+    std::vector<Token> tokens;
+    tokens.reserve((_end - _cur) / 4 + 16);
 
+    do {
+        tokens.push_back(getToken());
+    } while ( !tokens.back().eof() );
+
+    return tokens;
+}
+
+Token Lexer::getToken() {
+
+    if (_pendingCount > 0) {
+        if (debug)
+            std::cout << "_pendingCount > 0" << std::endl;
+        _pendingCount--;
+        return _pending;
     }
 
     if (startLine) {
+        fillLine();
+
         //Returns true if we consumed the entire line
         // and need to call getToken();
         if (consumeLeadingSpaces()) {
@@ -276,17 +373,15 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
 
         if (spacesConsumed > peekStack) {
             pythonLexSpace.push(spacesConsumed);
-            _tokens.emplace(new Token("INDENT"));
+            queue(Token(Token::KEYWORD, Token::INDENT));
 
         } else if (spacesConsumed < peekStack) {
             // DROP BACK DOWN to new scope @@ smaller 
             while (peekStack != spacesConsumed) {
-                _tokens.emplace(new Token("DEDENT"));
+                queue(Token(Token::KEYWORD, Token::DEDENT));
                 
-                if (pythonLexSpace.empty()) {
-                    std::cout << "Fatal Error in Lex::getToken()..couldn't parse spaces\n";
-                    exit(1);
-                }
+                if (pythonLexSpace.empty())
+                    fatal("Fatal Error in Lex::getToken()..couldn't parse spaces\n");
 
                 pythonLexSpace.pop();
                 peekStack = pythonLexSpace.top();
@@ -295,16 +390,9 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
         } else {;;}
 
         // If we added tokens to our queue we need to return them.
-        if (!_tokens.empty()) {
-            //Take from queue 
-            std::shared_ptr<Token> tok = _tokens.front();
-
-            //Save to processed tokens
-            _processedTokens.push_back(tok);
-
-            //Pop off stack
-            _tokens.pop();
-            return lastToken = tok;
+        if (_pendingCount > 0) {
+            _pendingCount--;
+            return _pending;
         }
     }
 
@@ -312,68 +400,116 @@ auto Lexer::getToken() -> std::shared_ptr<Token> {
     //Since those have been consumed we need to worry about spaces between words.
     //These are not recorded
 
-    auto token = std::make_shared<Token>();
+    Token token;
 
-    char c;
-    inStream.get(c);
+    int tabs = 0;
+    _cur = Scan::skipBlanks(_cur, _end, tabs);
 
-    while (c == ' ' && inStream.get(c));
+    // Lookahead is free, so the multi-char readers below start at `c` rather
+    // than having it pushed back. `start` is kept as a column because a
+    // streamed string literal may refill the window under it.
+    const char *start = _cur;
+    const std::size_t column = start - _lineStart;
+    char c = peek();
 
-    if (inStream.eof()) {
-        token->eof() = true;
+    if (atEnd()) {
+        token.setEof();
     } else if ( isdigit(c) || c == '.') {
-        inStream.putback(c);
         readNumber(false, token);
     } else if ( c == '-' ) {
-        token->symbol('-');
+        _cur++;
+        token.symbol('-');
     } else if ( isEqualityOperator(c) ) {
-        inStream.putback(c);
-        token->relExp( readEqualityOperator() );
+        token.relExp( readEqualityOperator() );
     } else if (c == '+' || c == '-' || c == '*' || c == '/' || c == '%' || c == ',' ||
                c == ';' || c == '(' || c == ')' || c == '{' || c == '}' || c == ':' || c == '[' || c == ']') {
-        token->symbol(c);
+        _cur++;
+        token.symbol(c);
      }
      else if ( c == '#' ) {
-         inStream.putback(c);
          consumeLine();
          return getToken();
      } else if ( c == '\'' || c == '"') {
-         inStream.putback(c);
-         token->setString( readString() );
+         std::uint32_t newlines;
+         std::size_t lineOffset;
+         token.setString( readString(newlines, lineOffset) );
+         if (newlines > 0) {
+             // Spanned from where it starts; what follows is on its last line.
+             token.setSpan(spanFrom(_lineStart + column));
+             _line += newlines;
+             _lineStart += lineOffset;
+             return token;
+         }
      } else if ( isalpha(c) || c == '_' ) {
-         inStream.putback(c);
-
-         std::string tokName = readName();
-         if (isKeyword(tokName)) {
-             token->setKeyword( tokName );
+         std::string_view tokName = readName();
+         Token::Op keyword = Keywords::lookup(tokName);
+         if (keyword != Token::NO_OP) {
+             token.setKeyword( keyword );
          } else {
-             token->setName( tokName );
+             std::string_view name;
+             Symbol symbol = Symbols::intern(tokName, &name);
+             token.setName( symbol, name );
          }
      } else if ( c == '\n' ) {
+         _cur++;
+         token.setEol();
+         token.setSpan(spanFrom(start));
+         newLine();
          startLine = true;
          _numTabs = 0;
          _numSpace = 0;
-         token->eol() = true;
+         return token;
 
      } else {
-         std::cout << "Unknown character in input. ->" << c << "<-\n";
-         exit(1); 
+         fatal(std::string("Unknown character in input. ->") + c + "<-\n");
      }
 
-     _processedTokens.push_back(token);
-     return lastToken = token;
+     token.setSpan(spanFrom(_lineStart + column));
+     return token;
 }
 
-void Lexer::printProcessedTokens() {
-    int i = 0;
-    for (auto &&tok : _processedTokens) {
-        std::cout << i << ": ";
-        tok->print();
-        std::cout << std::endl;
-        i++;
-    }
+std::string_view Lexer::keep(std::string_view text) {
+    char *copy = static_cast<char *>(_literals[_generation].allocate(text.size(), 1));
+    std::memcpy(copy, text.data(), text.size());
+    return std::string_view(copy, text.size());
 }
 
-void Lexer::ungetToken() {
-    ungottenToken = true;
+std::string_view Lexer::stable(std::string_view text) {
+    if (!_source.streaming())
+        return text;
+    return keep(text);
+}
+
+void Lexer::retire() {
+    if (!_source.streaming())
+        return;
+
+    // The oldest generation is reused; Mark{} is a fresh Arena's mark.
+    _generation = (_generation + 1) % generations;
+    _literals[_generation].rewind(Arena::Mark{});
+}
+
+bool Lexer::refill() {
+    const std::size_t cur = _cur - _lineStart;
+
+    bool more = _source.refill(_lineStart);
+
+    _lineStart = _source.begin();
+    _cur = _lineStart + cur;
+    _end = _source.end();
+    return more;
+}
+
+void Lexer::fillLine() {
+    if (!_source.streaming())
+        return;
+
+    // Only the bytes that arrived since the last look need scanning.
+    const char *scanned = _cur;
+    while (Scan::findNewline(scanned, _end) == _end) {
+        const std::size_t seen = _end - _cur;
+        if (!refill())
+            return;
+        scanned = _cur + seen;
+    }
 }
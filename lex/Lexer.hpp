@@ -1,46 +1,102 @@
 #ifndef __LEXER_HPP
 #define __LEXER_HPP
 
-#include <fstream>
+#include <string>
 #include <vector>
-#include <memory>
 #include <stack>
-#include <queue>
+#include <string_view>
 
 #include "../Debug.hpp"
 #include "../Token.hpp"
+#include "Source.hpp"
+#include "../Arena.hpp"
+
+// Thrown in place of a fatal syntax error, by the Lexer and the Parser,
+// on a thread that has set Lexer::abandonOnError.
+struct ParseAbandoned {};
 
 class Lexer {
 
 public:
-    Lexer(std::ifstream &inStream);
+    Lexer(Source &source);
+
+    // Lexes only [begin, end) of a non-streaming source, which must start at
+    // the beginning of line number `line`, outside any block (column 0).
+    Lexer(Source &source, const char *begin, const char *end, std::uint32_t line);
+
+    // Syntax errors normally print a message and exit. With this set, they
+    // throw ParseAbandoned instead and print nothing; ParallelParser's
+    // workers set it, and leave reporting to a serial parse.
+    static thread_local bool abandonOnError;
 
     bool consumeLeadingSpaces();
     int spacesConsumedOnLine();
 
     void consumeLine();
-    void readNumber(const bool, const std::shared_ptr<Token>&);
+    void readNumber(const bool, Token &);
 
-    void ungetToken();
+    // A literal may run on over escaped newlines. It doesn't move to the
+    // next line itself, since the token's span and a streamed refill both
+    // need the line it starts on; `newlines` is set to how many it crossed
+    // and `lineOffset` to where, from _lineStart, its last line begins.
+    std::string_view readString(std::uint32_t &newlines, std::size_t &lineOffset);
+    static std::string decodeEscapes(std::string_view);
 
-    std::string readString();
+    Token::Op readEqualityOperator();
+    std::string_view readName();
 
-    std::string readEqualityOperator();
-    std::string readName();
+    Token getToken();
 
-    std::shared_ptr<Token> getToken();
+    const Source &source() const { return _source; }
 
-    void printProcessedTokens();
+    // Lexes the whole input up front. The last token is always EOF.
+    std::vector<Token> tokenize();
+
+    // Streaming sources only: called each time the TokenStream forgets
+    // tokens. The text of literals lexed before the call two back is
+    // dropped; no token the stream still holds was lexed that early.
+    void retire();
 
 private:
 
-    std::shared_ptr<Token> lastToken;
-    bool ungottenToken;
+    bool atEnd() const { return _cur == _end; }
+    char peek() const  { return _cur < _end ? *_cur : '\0'; }
+
+    void newLine() { _line++; _lineStart = _cur; }
+    [[noreturn]] void fatal(const std::string &message);
+    Span spanFrom(const char *start) const;
+
+    // Streaming sources only: refill() pulls in more input, keeping the
+    // current line; fillLine() makes sure the whole of the next line is in
+    // the window before it is lexed.
+    bool refill();
+    void fillLine();
+
+    // Tokens only hold a slice of their text. Plain string literals point
+    // straight into the Source; decoded escaped literals are copied into
+    // the current generation of _literals.
+    std::string_view keep(std::string_view);
+
+    // Slices of a streaming Source only last until the next refill, so string
+    // literals are copied too, to last until retire() drops them. (Names are
+    // always interned in Symbols; a StringExp copies its text.)
+    std::string_view stable(std::string_view);
+
+    // Every token the line-start logic produces in one go is identical
+    // (one INDENT, n DEDENTs, one EOL or one EOF), so a count replaces a queue.
+    void queue(Token);
 
     std::stack<int> pythonLexSpace;
-    std::queue<std::shared_ptr<Token>> _tokens;
-    std::vector<std::shared_ptr<Token>> _processedTokens;
-    std::ifstream &inStream;
+    Token _pending;
+    int _pendingCount;
+    static const int generations = 3;
+    Arena _literals[generations];
+    int _generation;
+    Source &_source;
+    const char *_cur;
+    const char *_end;
+    const char *_lineStart;
+    std::uint32_t _line;
     int tokIdx;
 
     bool startLine;
@@ -0,0 +1,169 @@
+#include "Scan.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+    inline bool isIdentifierByte(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    // Scalar versions; also used by the vector kernels for the tail.
+
+    const char *skipBlanksScalar(const char *p, const char *end, int &tabs) {
+        for (; p < end; p++) {
+            if (*p == '\t')
+                tabs++;
+            else if (*p != ' ')
+                break;
+        }
+        return p;
+    }
+
+    const char *skipIdentifierScalar(const char *p, const char *end) {
+        while (p < end && isIdentifierByte(*p))
+            p++;
+        return p;
+    }
+
+    const char *findNewlineScalar(const char *p, const char *end) {
+        while (p < end && *p != '\n')
+            p++;
+        return p;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+
+    // (unsigned char)(c - lo) < n, lane-wise, with only signed compares.
+    inline __m128i inRange128(__m128i v, char lo, int n) {
+        __m128i shifted = _mm_xor_si128(_mm_sub_epi8(v, _mm_set1_epi8(lo)), _mm_set1_epi8((char) 0x80));
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char) (n - 128)));
+    }
+
+    inline __m128i identifierMask128(__m128i v) {
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i m = _mm_or_si128(inRange128(lower, 'a', 26), inRange128(v, '0', 10));
+        return _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+    }
+
+    const char *skipBlanksSSE2(const char *p, const char *end, int &tabs) {
+        const __m128i space = _mm_set1_epi8(' ');
+        const __m128i tab = _mm_set1_epi8('\t');
+
+        for (; end - p >= 16; p += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            unsigned tabMask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, tab));
+            unsigned blankMask = tabMask | _mm_movemask_epi8(_mm_cmpeq_epi8(v, space));
+
+            if (blankMask != 0xFFFF) {
+                int stop = __builtin_ctz(~blankMask);
+                tabs += __builtin_popcount(tabMask & ((1u << stop) - 1));
+                return p + stop;
+            }
+            tabs += __builtin_popcount(tabMask);
+        }
+        return skipBlanksScalar(p, end, tabs);
+    }
+
+    const char *skipIdentifierSSE2(const char *p, const char *end) {
+        for (; end - p >= 16; p += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            unsigned mask = _mm_movemask_epi8(identifierMask128(v));
+            if (mask != 0xFFFF)
+                return p + __builtin_ctz(~mask);
+        }
+        return skipIdentifierScalar(p, end);
+    }
+
+    const char *findNewlineSSE2(const char *p, const char *end) {
+        const __m128i newline = _mm_set1_epi8('\n');
+
+        for (; end - p >= 16; p += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, newline));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+        return findNewlineScalar(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256i inRange256(__m256i v, char lo, int n) {
+        __m256i shifted = _mm256_xor_si256(_mm256_sub_epi8(v, _mm256_set1_epi8(lo)), _mm256_set1_epi8((char) 0x80));
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (n - 128)), shifted);
+    }
+
+    __attribute__((target("avx2")))
+    const char *skipBlanksAVX2(const char *p, const char *end, int &tabs) {
+        const __m256i space = _mm256_set1_epi8(' ');
+        const __m256i tab = _mm256_set1_epi8('\t');
+
+        for (; end - p >= 32; p += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            unsigned tabMask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, tab));
+            unsigned blankMask = tabMask | (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, space));
+
+            if (blankMask != 0xFFFFFFFFu) {
+                int stop = __builtin_ctz(~blankMask);
+                tabs += __builtin_popcount(tabMask & ((1u << stop) - 1));
+                return p + stop;
+            }
+            tabs += __builtin_popcount(tabMask);
+        }
+        return skipBlanksSSE2(p, end, tabs);
+    }
+
+    __attribute__((target("avx2")))
+    const char *skipIdentifierAVX2(const char *p, const char *end) {
+        for (; end - p >= 32; p += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+            __m256i m = _mm256_or_si256(inRange256(lower, 'a', 26), inRange256(v, '0', 10));
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+
+            unsigned mask = _mm256_movemask_epi8(m);
+            if (mask != 0xFFFFFFFFu)
+                return p + __builtin_ctz(~mask);
+        }
+        return skipIdentifierSSE2(p, end);
+    }
+
+    __attribute__((target("avx2")))
+    const char *findNewlineAVX2(const char *p, const char *end) {
+        const __m256i newline = _mm256_set1_epi8('\n');
+
+        for (; end - p >= 32; p += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+            unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, newline));
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+        return findNewlineSSE2(p, end);
+    }
+
+#endif
+
+    Scan::Kernels select() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return Scan::avx2Kernels;
+        if (__builtin_cpu_supports("sse2"))
+            return Scan::sse2Kernels;
+#endif
+        return Scan::scalarKernels;
+    }
+}
+
+namespace Scan {
+
+    const Kernels scalarKernels = { skipBlanksScalar, skipIdentifierScalar, findNewlineScalar, "scalar" };
+#if defined(__x86_64__) || defined(__i386__)
+    const Kernels sse2Kernels = { skipBlanksSSE2, skipIdentifierSSE2, findNewlineSSE2, "sse2" };
+    const Kernels avx2Kernels = { skipBlanksAVX2, skipIdentifierAVX2, findNewlineAVX2, "avx2" };
+#endif
+
+    const Kernels kernels = select();
+};
@@ -0,0 +1,45 @@
+#ifndef __SCAN_HPP
+#define __SCAN_HPP
+
+// Byte-scanning kernels for the Lexer's hot loops. Each kernel exists as a
+// scalar loop, an SSE2 version (16 bytes per step) and an AVX2 version (32
+// bytes per step); the widest one the CPU supports is picked once at start-up.
+namespace Scan {
+
+    struct Kernels {
+        // First byte in [p, end) that is neither ' ' nor '\t'. Adds the number
+        // of tabs skipped to `tabs`.
+        const char *(*skipBlanks)(const char *p, const char *end, int &tabs);
+
+        // First byte in [p, end) that is not [A-Za-z0-9_].
+        const char *(*skipIdentifier)(const char *p, const char *end);
+
+        // First '\n' in [p, end), or `end`.
+        const char *(*findNewline)(const char *p, const char *end);
+
+        const char *name;
+    };
+
+    extern const Kernels kernels;
+
+    inline const char *skipBlanks(const char *p, const char *end, int &tabs) {
+        return kernels.skipBlanks(p, end, tabs);
+    }
+
+    inline const char *skipIdentifier(const char *p, const char *end) {
+        return kernels.skipIdentifier(p, end);
+    }
+
+    inline const char *findNewline(const char *p, const char *end) {
+        return kernels.findNewline(p, end);
+    }
+
+    // The individual implementations, for benchmarks and cross-checking.
+    extern const Kernels scalarKernels;
+#if defined(__x86_64__) || defined(__i386__)
+    extern const Kernels sse2Kernels;
+    extern const Kernels avx2Kernels;
+#endif
+};
+
+#endif
@@ -0,0 +1,170 @@
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Source.hpp"
+
+Source::Source(std::string name):
+    _name{name},
+    _data{""},
+    _size{0},
+    _mapped{false},
+    _fd{-1},
+    _ownsFd{false},
+    _eof{false},
+    _base{0}
+{}
+
+Source::~Source() {
+    if (_mapped)
+        munmap(const_cast<char *>(_data), _size);
+    if (_ownsFd)
+        close(_fd);
+}
+
+std::unique_ptr<Source> Source::open(const std::string &path) {
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+
+    std::unique_ptr<Source> src = fromFd(fd, path);
+
+    if (src != nullptr && src->streaming()) {
+        src->_ownsFd = true;
+        return src;
+    }
+
+    int savedErrno = errno;
+    close(fd);
+    errno = savedErrno;
+    return src;
+}
+
+std::unique_ptr<Source> Source::fromFd(int fd, std::string name) {
+
+    std::unique_ptr<Source> src{new Source(name)};
+
+    struct stat st;
+    bool haveStat = fstat(fd, &st) == 0;
+
+    if (haveStat && !S_ISREG(st.st_mode)) {
+        src->stream(fd);
+        return src;
+    }
+
+    bool ok = haveStat && st.st_size > 0 && src->map(fd, st.st_size);
+
+    // Fall back to a single buffer for anything mmap can't handle.
+    if (!ok)
+        ok = src->readAll(fd);
+
+    if (!ok)
+        return nullptr;
+    return src;
+}
+
+std::unique_ptr<Source> Source::fromString(std::string text) {
+    std::unique_ptr<Source> src{new Source("<string>")};
+    src->_buffer = std::move(text);
+    src->_data = src->_buffer.data();
+    src->_size = src->_buffer.size();
+    return src;
+}
+
+std::string_view Source::lineAt(std::size_t offset) const {
+
+    if (offset < _base)
+        return std::string_view();
+
+    offset -= _base;
+    if (offset > _size)
+        offset = _size;
+
+    std::size_t start = offset;
+    while (start > 0 && _data[start - 1] != '\n')
+        start--;
+
+    std::size_t stop = offset;
+    while (stop < _size && _data[stop] != '\n')
+        stop++;
+
+    return std::string_view(_data + start, stop - start);
+}
+
+bool Source::map(int fd, std::size_t size) {
+
+    void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED)
+        return false;
+
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    _data = static_cast<const char *>(p);
+    _size = size;
+    _mapped = true;
+    return true;
+}
+
+bool Source::readAll(int fd) {
+
+    char chunk[64 * 1024];
+    ssize_t n;
+
+    while ((n = read(fd, chunk, sizeof(chunk))) != 0) {
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        _buffer.append(chunk, n);
+    }
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+    return true;
+}
+
+void Source::stream(int fd) {
+    _fd = fd;
+    _buffer.resize(streamWindow);
+    _data = _buffer.data();
+    _size = 0;
+}
+
+bool Source::refill(const char *keepFrom) {
+
+    std::size_t kept = _data + _size - keepFrom;
+    _base += keepFrom - _data;
+    std::memmove(&_buffer[0], keepFrom, kept);
+
+    if (kept == _buffer.size())
+        _buffer.resize(2 * _buffer.size());
+    _data = _buffer.data();
+    _size = kept;
+
+    if (_eof)
+        return false;
+
+    ssize_t n;
+    do {
+        n = read(_fd, &_buffer[kept], _buffer.size() - kept);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0) {
+        std::cout << "Fatal Error Source::refill.. reading " << _name << ": " << strerror(errno) << std::endl;
+        exit(1);
+    }
+
+    if (n == 0) {
+        _eof = true;
+        return false;
+    }
+
+    _size += n;
+    return true;
+}
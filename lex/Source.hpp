@@ -0,0 +1,76 @@
+#ifndef __SOURCE_HPP
+#define __SOURCE_HPP
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// A Source owns the text of an input program as one contiguous, read-only
+// buffer. Regular files are mmap'd (or read() whole if they can't be).
+// The Lexer scans it with a plain pointer, so lookahead costs nothing.
+//
+// Pipes, FIFOs, sockets and terminals are streamed instead: the buffer is a
+// fixed-size window that the Lexer refills as it goes, so memory stays flat
+// however long the input is. Only a single line longer than the window
+// makes it grow.
+class Source {
+
+public:
+    ~Source();
+
+    Source(const Source &) = delete;
+    Source &operator=(const Source &) = delete;
+
+    // Returns nullptr (with errno set) if the file can't be opened.
+    static std::unique_ptr<Source> open(const std::string &path);
+    static std::unique_ptr<Source> fromString(std::string text);
+
+    // For an already open descriptor such as stdin, which stays open.
+    static std::unique_ptr<Source> fromFd(int fd, std::string name);
+
+    static const std::size_t streamWindow = 64 * 1024;
+
+    const char *begin() const { return _data; }
+    const char *end() const   { return _data + _size; }
+    std::size_t size() const  { return _size; }
+
+    const std::string &name() const { return _name; }
+
+    bool streaming() const { return _fd >= 0; }
+    // True once there is nothing left to refill; always true unless streaming.
+    bool exhausted() const { return _fd < 0 || _eof; }
+
+    // Byte offset of `p` from the start of the input, which differs from
+    // p - begin() once a stream has been refilled.
+    std::size_t offsetOf(const char *p) const { return _base + (p - _data); }
+
+    // Streaming only. Drops the bytes before `keepFrom`, slides the rest to
+    // the front of the window and reads more after them. Every pointer into
+    // the buffer is invalid afterwards. Returns false at end of input.
+    bool refill(const char *keepFrom);
+
+    // The full line (without its newline) containing byte `offset`, or an
+    // empty view if a stream has already dropped it.
+    std::string_view lineAt(std::size_t offset) const;
+
+private:
+    Source(std::string name);
+
+    bool map(int fd, std::size_t size);
+    bool readAll(int fd);
+    void stream(int fd);
+
+    std::string _name;
+    const char *_data;
+    std::size_t _size;
+    bool _mapped;
+    std::string _buffer;
+
+    int _fd;
+    bool _ownsFd;
+    bool _eof;
+    std::size_t _base;
+};
+
+#endif
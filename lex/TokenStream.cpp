@@ -0,0 +1,53 @@
+#include <iostream>
+
+#include "TokenStream.hpp"
+
+TokenStream::TokenStream(Lexer &lexer, bool preTokenize):
+    _lexer{lexer},
+    _pos{0},
+    _released{0},
+    _preTokenized{preTokenize}
+{
+    if (preTokenize)
+        _tokens = _lexer.tokenize();
+}
+
+void TokenStream::fill(std::size_t index) {
+
+    // Past EOF the stream keeps answering EOF.
+    while ( _tokens.size() <= index ) {
+        if ( !_tokens.empty() && _tokens.back().eof() ) {
+            _tokens.push_back(_tokens.back());
+            continue;
+        }
+        _tokens.push_back(_lexer.getToken());
+    }
+}
+
+void TokenStream::release() {
+
+    // Dropping in batches keeps the erase cost per token constant.
+    if (_preTokenized || _pos < 2 * keptTokens)
+        return;
+
+    std::size_t drop = _pos - keptTokens;
+    _tokens.erase(_tokens.begin(), _tokens.begin() + drop);
+    _pos -= drop;
+    _released += drop;
+
+    // Every token kept was still ahead of _pos at the previous release, so
+    // it was lexed after the one before that: the Parser never peeks
+    // keptTokens ahead.
+    _lexer.retire();
+}
+
+void TokenStream::printRecentTokens(std::size_t count) const {
+    std::size_t stop = _pos < _tokens.size() ? _pos : _tokens.size();
+    std::size_t start = stop > count ? stop - count : 0;
+
+    for (std::size_t i = start; i < stop; i++) {
+        std::cout << _released + i << ": ";
+        _tokens[i].print();
+        std::cout << std::endl;
+    }
+}
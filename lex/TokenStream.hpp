@@ -0,0 +1,60 @@
+#ifndef __TOKEN_STREAM_HPP
+#define __TOKEN_STREAM_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "../Token.hpp"
+#include "Lexer.hpp"
+
+// The Parser's view of the token stream: one contiguous vector walked with
+// an index. Lookahead is peek(k), backtracking is reset(mark()).
+//
+// With preTokenize the Lexer runs over the whole input up front and the
+// vector is filled in one go; otherwise tokens are pulled from the Lexer
+// only as far as the Parser looks ahead, and release() drops the ones it is
+// done with, so a streamed program never holds more than a statement's worth.
+class TokenStream {
+
+public:
+    TokenStream(Lexer &lexer, bool preTokenize);
+
+    const Token &peek(std::size_t k = 0) {
+        if (_pos + k >= _tokens.size())
+            fill(_pos + k);
+        return _tokens[_pos + k];
+    }
+
+    Token getToken() {
+        peek();
+        return _tokens[_pos++];
+    }
+
+    void ungetToken() { _pos--; }
+
+    std::size_t mark() const { return _pos; }
+    void reset(std::size_t mark) { _pos = mark; }
+
+    // Forgets consumed tokens, except the last few kept for
+    // printRecentTokens. Marks taken before a release are invalid after it.
+    // Does nothing on a pre-tokenized stream.
+    void release();
+
+    const Source &source() const { return _lexer.source(); }
+
+    // Prints up to the last `count` tokens the Parser has consumed.
+    void printRecentTokens(std::size_t count) const;
+
+private:
+    void fill(std::size_t index);
+
+    static const std::size_t keptTokens = 16;
+
+    Lexer &_lexer;
+    std::vector<Token> _tokens;
+    std::size_t _pos;
+    std::size_t _released;
+    bool _preTokenized;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include <iostream>
+#include <thread>
 #include <vector>
 #include <sys/time.h>
 #include <sys/resource.h>
@@ -6,9 +7,43 @@
 #include "Token.hpp"
 #include "Parser.hpp"
 #include "Debug.hpp"
+#include "FlatExpr.hpp"
+#include "ProgramCache.hpp"
+#include "ParallelParser.hpp"
+#include "Pool.hpp"
 
 #include "./lex/Lexer.hpp"
+#include "./lex/Source.hpp"
+#include "./lex/TokenStream.hpp"
 #include "./statements/Statement.hpp"
+#include "./passes/Flatten.hpp"
+#include "./passes/Fold.hpp"
+#include "./passes/DeadBranches.hpp"
+#include "./passes/Resolve.hpp"
+#include "./passes/Infer.hpp"
+
+// How many string allocations the Pool served, and how few of them
+// reached the global heap.
+void reportPool() {
+    const Pool::Stats &stats = Pool::stats();
+    std::cerr << "pool: " << stats.allocations << " allocations, " << stats.releases << " releases, "
+              << stats.slabs << " slabs from the heap, " << stats.oversized << " too large" << std::endl;
+}
+
+// True if `stmts` holds a def anywhere, however deeply nested in if or
+// for bodies: evaluating it may leave a function body in the SymTab.
+bool definesFunction(Statements &stmts) {
+    for (auto &&stmt : stmts._statements) {
+        if ( dynamic_cast<FunctionDefinition *>(stmt.get()) != nullptr )
+            return true;
+
+        bool found = false;
+        stmt->visitSuites([&](Statements &suite) { found = found || definesFunction(suite); });
+        if ( found )
+            return true;
+    }
+    return false;
+}
 
 long getMemoryUsage() 
 {
@@ -21,16 +56,58 @@ long getMemoryUsage()
 
 int main(int argc, char *argv[]) {
 
-    if( argc != 2) {
-        std::cout << "usage: " << argv[0] << " nameOfAnInputFile\n";
+    // Options come before the file name:
+    //   -flat        evaluate expressions from the flattened FlatTree layout
+    //                instead of walking the ExprNode trees.
+    //   -cache dir   keep compiled programs in dir and reuse them (see
+    //                ProgramCache.hpp). A piped program is never cached.
+    //   -nofold      skip constant folding (passes/Fold.hpp) and with it
+    //                dead-branch elimination (passes/DeadBranches.hpp).
+    //   -dumpfold    print every expression folded and branch pruned.
+    //   -j n         parse a large file on n threads (ParallelParser.hpp);
+    //                the default is one per core, and -j 1 parses serially.
+    //   -poolstats   print the Pool's allocation counters to stderr at the end.
+    const char *program = argv[0];
+    bool flat = false;
+    bool fold = true;
+    bool dumpFold = false;
+    bool poolStats = false;
+    const char *cacheDir = nullptr;
+    unsigned threads = std::thread::hardware_concurrency();
+
+    for ( ; argc > 1; argv++, argc-- ) {
+        std::string option = argv[1];
+        if ( option == "-flat" )
+            flat = true;
+        else if ( option == "-nofold" )
+            fold = false;
+        else if ( option == "-dumpfold" )
+            dumpFold = true;
+        else if ( option == "-poolstats" )
+            poolStats = true;
+        else if ( option == "-cache" && argc > 2 ) {
+            cacheDir = argv[2];
+            argv++;
+            argc--;
+        } else if ( option == "-j" && argc > 2 ) {
+            threads = std::stoi(argv[2]);
+            argv++;
+            argc--;
+        } else
+            break;
+    }
+
+    if( argc > 2) {
+        std::cout << "usage: " << program << " [-flat] [-cache dir] [-nofold] [-dumpfold] [-poolstats] [-j n] [nameOfAnInputFile | -]\n";
         exit(1);
     }
 
-    std::ifstream inputStream;
+    // No file (or "-") reads the program from stdin.
+    bool fromStdin = argc == 1 || std::string(argv[1]) == "-";
 
-    inputStream.open(argv[1], std::ios::in);
-    if( ! inputStream.is_open() ) {
-        std::cout << "Unable top open " << argv[1] << ". Terminating...";
+    std::unique_ptr<Source> source = fromStdin ? Source::fromFd(0, "<stdin>") : Source::open(argv[1]);
+    if( source == nullptr ) {
+        std::cout << "Unable top open " << (fromStdin ? "<stdin>" : argv[1]) << ". Terminating...";
         perror("Error when attempting to open the input file.");
         exit(2);
     }
@@ -38,24 +115,118 @@ int main(int argc, char *argv[]) {
 
 
 
+    // A tree loaded from the cache points into its mapping.
+    std::unique_ptr<ProgramCache> cache;
+    // So does one parsed in chunks, into the chunks' arenas.
+    std::unique_ptr<ParallelParser> parallel;
+
+    // The whole tree lives here. It must outlive the SymTab, which keeps
+    // function bodies.
+    Arena arena;
+    FlatTree flatTree;
+
     SymTab symTab;
-    Lexer lex = Lexer(inputStream);
+    Passes::TypeEnv types;
+    Lexer lex = Lexer(*source);
+
+    // A piped program runs one top-level statement at a time as it streams
+    // in, so neither its text nor its tree is ever held whole. (There is
+    // nothing left to dump at the end.)
+    if ( source->streaming() ) {
+        TokenStream tokens(lex, false);
+        Parser parser(tokens, arena);
+
+        while ( true ) {
+            Arena::Mark mark = arena.mark();
+            std::size_t flatMark = flatTree.size();
+            auto stmt = parser.next_stmt();
+            if ( stmt == nullptr )
+                break;
+
+            // Pruning can replace the statement with the branch it always
+            // takes, so the passes see it as a suite of its own.
+            auto suite = arena.make<Statements>(arena);
+            suite->addStatement(std::move(stmt));
+
+            if ( fold ) {
+                // Fold's identities need types; the real inference runs
+                // on the pruned tree below and retags every node.
+                Passes::TypeEnv scratch = types;
+                Passes::inferTypes(*suite, scratch);
+                Passes::fold(*suite, arena, dumpFold);
+                Passes::eliminateDeadBranches(*suite, arena, dumpFold);
+            }
+            Passes::resolveSlots(*suite, symTab);
+            Passes::inferTypes(*suite, types);
+            if ( flat )
+                Passes::flatten(*suite, flatTree, arena);
 
-    // auto tok = lex.getToken();
+            // A def hands its body to the SymTab; anything else is done with.
+            bool keep = definesFunction(*suite);
+            suite->evaluate(symTab);
 
-    // while ( !tok->eof() ) {
-    //   tok->print();
-    //   tok = lex.getToken();
-    //   std::cout << std::endl;
-    // }
-    Parser parser(lex);
-    // std::unique_ptr<GroupedStatements> stmts =  parser.file_input();
-    auto stmts = parser.file_input();
+            if ( !keep ) {
+                arena.rewind(mark);
+                flatTree.truncate(flatMark);
+            }
+        }
+
+        if ( poolStats )
+            reportPool();
+        return 0;
+    }
+
+    ArenaPtr<Statements> stmts;
+
+    // A cached program skips the Lexer and Parser altogether.
+    if ( cacheDir != nullptr ) {
+        cache = std::make_unique<ProgramCache>(cacheDir, *source);
+        stmts = cache->load(arena);
+    }
+    bool parsed = stmts == nullptr;
+
+    if ( stmts == nullptr && threads > 1 && source->size() >= ParallelParser::minimumSize ) {
+        parallel = std::make_unique<ParallelParser>(*source, threads);
+        stmts = parallel->file_input(arena);
+    }
+
+    // Also reports any syntax error the parallel parse gave up on.
+    if ( stmts == nullptr ) {
+        TokenStream tokens(lex, true);
+
+        // auto tok = lex.getToken();
+
+        // while ( !tok->eof() ) {
+        //   tok->print();
+        //   tok = lex.getToken();
+        //   std::cout << std::endl;
+        // }
+        Parser parser(tokens, arena);
+        // std::unique_ptr<GroupedStatements> stmts =  parser.file_input();
+        stmts = parser.file_input();
+    }
+
+    if ( parsed && cache != nullptr && !cache->store(*stmts) && debug )
+        std::cout << "main: could not write " << cache->path() << std::endl;
+
+    // The cache holds the tree as parsed; passes run after it is stored or loaded.
+    if ( fold ) {
+        Passes::TypeEnv scratch = types;
+        Passes::inferTypes(*stmts, scratch);
+        Passes::fold(*stmts, arena, dumpFold);
+        Passes::eliminateDeadBranches(*stmts, arena, dumpFold);
+    }
+    Passes::resolveSlots(*stmts, symTab);
+    Passes::inferTypes(*stmts, types);
+    if ( flat )
+        Passes::flatten(*stmts, flatTree, arena);
 
     stmts->evaluate(symTab);
     // std::cout << "Evaluate Done - Dumping Tree" << std::endl;
 //    std::cout << getMemoryUsage() << std::endl;
    stmts->dumpAST("");
 
+    if ( poolStats )
+        reportPool();
     return 0;
 }
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <optional>
+#include <vector>
+
+#include "DeadBranches.hpp"
+
+namespace {
+
+    class Pruner {
+
+    public:
+        Pruner(Arena &arena, bool log):
+            _arena{arena},
+            _log{log},
+            _resolved{0}
+        {}
+
+        int resolved() const { return _resolved; }
+
+        void prune(Statements &stmts) {
+
+            // Only built once a statement has to be replaced.
+            std::optional<ArenaVector<ArenaPtr<Statement>>> kept;
+
+            for (std::size_t i = 0; i < stmts._statements.size(); i++) {
+                auto &stmt = stmts._statements[i];
+
+                // FunctionCall checks a body's statement count against its
+                // arguments, so bodies keep their shape.
+                if ( dynamic_cast<FunctionDefinition *>(stmt.get()) == nullptr )
+                    stmt->visitSuites([this](Statements &inner) { prune(inner); });
+
+                auto ifStatement = dynamic_cast<IfStatement *>(stmt.get());
+                ArenaPtr<Statements> *taken = nullptr;
+                bool replace = ifStatement != nullptr && resolve(*ifStatement, taken);
+
+                if ( replace && !kept ) {
+                    kept.emplace(_arena);
+                    for (std::size_t j = 0; j < i; j++)
+                        kept->push_back(std::move(stmts._statements[j]));
+                }
+                if ( !kept )
+                    continue;
+
+                if ( !replace )
+                    kept->push_back(std::move(stmt));
+                else if ( taken != nullptr )
+                    for (auto &&s : (*taken)->_statements)
+                        kept->push_back(std::move(s));
+            }
+
+            if ( kept )
+                stmts._statements = std::move(*kept);
+        }
+
+    private:
+        // Rewrites `ifStatement` if any of its conditions is constant. If a
+        // conditional branch is left it is rebuilt in place; otherwise this
+        // returns true and the caller replaces it with `taken`, the suite
+        // that always runs, or removes it if `taken` is null.
+        bool resolve(IfStatement &ifStatement, ArenaPtr<Statements> *&taken) {
+
+            std::vector<Clause *> clauses;
+            if ( ifStatement.ifClause() != nullptr )
+                clauses.push_back(&ifStatement.ifClause()->clause());
+            if ( ifStatement.elifClauses() != nullptr )
+                for (auto &&clause : ifStatement.elifClauses()->clauses())
+                    clauses.push_back(&clause);
+
+            ArenaPtr<Statements> *otherwise = nullptr;
+            if ( ifStatement.elseClause() != nullptr )
+                otherwise = &ifStatement.elseClause()->suite();
+
+            std::vector<Clause *> live;
+            int before = _resolved;
+
+            for (auto clause : clauses) {
+                auto literal = dynamic_cast<BoolLiteral *>(clause->first.get());
+                if ( literal == nullptr ) {
+                    live.push_back(clause);
+                    continue;
+                }
+
+                _resolved++;
+                unsigned line = literal->token()->span().line;
+
+                if ( literal->token()->getWholeNumber() == 0 ) {
+                    if ( _log )
+                        std::cout << "prune line " << line << ": False branch dropped" << std::endl;
+                    continue;
+                }
+
+                if ( _log )
+                    std::cout << "prune line " << line << ": True branch always taken, later branches dropped" << std::endl;
+                otherwise = &clause->second;
+                break;
+            }
+
+            if ( _resolved == before )
+                return false;
+
+            if ( live.empty() ) {
+                taken = otherwise;
+                return true;
+            }
+
+            ArenaPtr<Statements> elseSuite;
+            if ( otherwise != nullptr )
+                elseSuite = std::move(*otherwise);
+
+            ArenaPtr<ElifStmt> elif;
+            if ( live.size() > 1 ) {
+                elif = _arena.make<ElifStmt>(_arena);
+                for (std::size_t i = 1; i < live.size(); i++)
+                    elif->addStatement(std::move(live[i]->first), std::move(live[i]->second));
+            }
+
+            ifStatement.addIfStmt(_arena.make<IfStmt>(std::move(live[0]->first), std::move(live[0]->second)));
+            ifStatement.addElifStmt(std::move(elif));
+            ifStatement.addElseStmt(elseSuite == nullptr ? nullptr : _arena.make<ElseStmt>(std::move(elseSuite)));
+            return false;
+        }
+
+        Arena &_arena;
+        bool _log;
+        int _resolved;
+    };
+};
+
+namespace Passes {
+
+    int eliminateDeadBranches(Statements &stmts, Arena &arena, bool log) {
+        Pruner p(arena, log);
+        p.prune(stmts);
+        return p.resolved();
+    }
+};
@@ -0,0 +1,22 @@
+#ifndef __DEAD_BRANCHES_HPP
+#define __DEAD_BRANCHES_HPP
+
+#include "../Arena.hpp"
+#include "../statements/Statement.hpp"
+
+namespace Passes {
+
+    // Dead-branch elimination, meant to run after fold(). An if or elif
+    // whose condition folded to a BoolLiteral is resolved here: a False
+    // branch is dropped, and a True one becomes the else, dropping every
+    // branch after it. An if statement left with only its else is replaced
+    // by that suite's statements, spliced into the enclosing suite, and one
+    // left with nothing is removed. Other conditions, including constants
+    // that are not bools (which IfStmt rejects at run time), are untouched.
+    //
+    // Nested suites are pruned first, except function bodies. With `log`, each resolved branch is
+    // printed. Returns the number of branches resolved.
+    int eliminateDeadBranches(Statements &stmts, Arena &arena, bool log);
+};
+
+#endif
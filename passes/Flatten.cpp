@@ -0,0 +1,26 @@
+#include "Flatten.hpp"
+
+namespace {
+
+    ExprSlotVisitor flattener(FlatTree &tree, Arena &arena) {
+        return [&tree, &arena](ArenaPtr<ExprNode> &slot) {
+            if ( dynamic_cast<FunctionCall *>(slot.get()) != nullptr )
+                return;
+
+            ExprNode *original = slot.release();
+            FlatTree::Index root = tree.flatten(original);
+            slot = arena.make<FlatExprNode>(tree, root, original);
+        };
+    }
+}
+
+namespace Passes {
+
+    void flatten(Statements &stmts, FlatTree &tree, Arena &arena) {
+        stmts.visitExprs(flattener(tree, arena));
+    }
+
+    void flatten(Statement &stmt, FlatTree &tree, Arena &arena) {
+        stmt.visitExprs(flattener(tree, arena));
+    }
+};
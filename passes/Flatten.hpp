@@ -0,0 +1,18 @@
+#ifndef __FLATTEN_HPP
+#define __FLATTEN_HPP
+
+#include "../Arena.hpp"
+#include "../FlatExpr.hpp"
+#include "../statements/Statement.hpp"
+
+namespace Passes {
+
+    // Moves every expression in `stmts` into `tree` and puts a FlatExprNode
+    // (allocated in `arena`) in its place. A FunctionCall is kept as it is.
+    void flatten(Statements &stmts, FlatTree &tree, Arena &arena);
+
+    // The same, for one top-level statement.
+    void flatten(Statement &stmt, FlatTree &tree, Arena &arena);
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "Fold.hpp"
+
+namespace {
+
+    const int UNKNOWN = -1;
+
+    // The descriptor type an expression always evaluates to, or UNKNOWN.
+    int literalType(ExprNode *node) {
+        if ( dynamic_cast<WholeNumber *>(node) ) return TypeDescriptor::INTEGER;
+        if ( dynamic_cast<Double *>(node) )      return TypeDescriptor::DOUBLE;
+        if ( dynamic_cast<StringExp *>(node) )   return TypeDescriptor::STRING;
+        if ( dynamic_cast<BoolLiteral *>(node) ) return TypeDescriptor::BOOL;
+        return UNKNOWN;
+    }
+
+    // What passes/Infer.hpp tagged `node` with, if it has run, or what the
+    // kind of node alone proves.
+    int staticType(ExprNode *node) {
+        if ( node->staticType() != ExprNode::UNTYPED )
+            return node->staticType();
+        if ( dynamic_cast<ComparisonExprNode *>(node) || dynamic_cast<BooleanExprNode *>(node) )
+            return TypeDescriptor::BOOL;
+        return literalType(node);
+    }
+
+    bool isNumber(int type) {
+        return type == TypeDescriptor::INTEGER || type == TypeDescriptor::DOUBLE || type == TypeDescriptor::BOOL;
+    }
+
+    bool isInt(ExprNode *node, std::int64_t value) {
+        return literalType(node) == TypeDescriptor::INTEGER && node->token()->getWholeNumber() == value;
+    }
+
+    // Whether evaluating `node`, whose operands are the literals of types
+    // `l` and `r`, goes through the Descriptor functions without an error,
+    // a warning or undefined behaviour. Mirrors the kernels in Dispatch.cpp.
+    bool safeToFold(ExprNode *node, int l, int r) {
+
+        const Token *tok = node->token();
+
+        if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+            if ( infix->_right == nullptr )
+                return l == TypeDescriptor::DOUBLE ||
+                       ( l == TypeDescriptor::INTEGER && infix->_left->token()->getWholeNumber() != INT64_MIN );
+
+            if ( l == TypeDescriptor::STRING && r == TypeDescriptor::STRING )
+                return tok->isAdditionOperator();
+            if ( l == TypeDescriptor::DOUBLE && r == TypeDescriptor::DOUBLE )
+                return true;
+            if ( l != TypeDescriptor::INTEGER || r != TypeDescriptor::INTEGER )
+                return false;
+
+            std::int64_t lhs = infix->_left->token()->getWholeNumber();
+            std::int64_t rhs = infix->_right->token()->getWholeNumber();
+            std::int64_t result;
+
+            if ( tok->isDivisionOperator() || tok->isModuloOperator() )
+                return rhs != 0 && !( lhs == INT64_MIN && rhs == -1 );
+            if ( tok->isAdditionOperator() )
+                return !__builtin_add_overflow(lhs, rhs, &result);
+            if ( tok->isSubtractionOperator() )
+                return !__builtin_sub_overflow(lhs, rhs, &result);
+            return !__builtin_mul_overflow(lhs, rhs, &result);
+        }
+
+        if ( dynamic_cast<ComparisonExprNode *>(node) ) {
+            if ( l == TypeDescriptor::STRING || r == TypeDescriptor::STRING )
+                return l == r;
+            return isNumber(l) && isNumber(r);
+        }
+
+        if ( tok->isNot() )
+            return l != UNKNOWN;
+
+        return isNumber(l) && isNumber(r);
+    }
+
+    std::string render(ExprNode *node);
+
+    std::string renderBinary(ExprNode *left, const std::string &op, ExprNode *right) {
+        return "(" + render(left) + " " + op + " " + render(right) + ")";
+    }
+
+    std::string opText(const Token *tok) {
+        if ( tok->isRelOp() )                  return tok->getRelOp();
+        if ( tok->isAdditionOperator() )       return "+";
+        if ( tok->isSubtractionOperator() )    return "-";
+        if ( tok->isMultiplicationOperator() ) return "*";
+        if ( tok->isDivisionOperator() )       return "/";
+        if ( tok->isModuloOperator() )         return "%";
+        if ( tok->isAnd() )                    return "and";
+        if ( tok->isOr() )                     return "or";
+        return "not";
+    }
+
+    // One line of Python-ish text for the fold log.
+    std::string render(ExprNode *node) {
+
+        const Token *tok = node->token();
+
+        if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+            if ( infix->_right == nullptr )
+                return "-" + render(infix->_left.get());
+            return renderBinary(infix->_left.get(), opText(tok), infix->_right.get());
+        }
+        if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) )
+            return renderBinary(comparison->_left.get(), opText(tok), comparison->_right.get());
+        if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) ) {
+            if ( tok->isNot() )
+                return "not " + render(boolean->_left.get());
+            return renderBinary(boolean->_left.get(), opText(tok), boolean->_right.get());
+        }
+
+        switch ( literalType(node) ) {
+            case TypeDescriptor::INTEGER:
+                return std::to_string(tok->getWholeNumber());
+            case TypeDescriptor::DOUBLE: {
+                char buf[32];
+                int n = snprintf(buf, sizeof(buf), "%.12g", tok->getFloat());
+                std::string text(buf, n);
+                return text.find_first_of(".eni") == std::string::npos ? text + ".0" : text;
+            }
+            case TypeDescriptor::STRING:
+                return "\"" + std::string(tok->getText()) + "\"";
+            case TypeDescriptor::BOOL:
+                return tok->getWholeNumber() ? "True" : "False";
+        }
+
+        if ( dynamic_cast<FunctionCall *>(node) )
+            return std::string(tok->getText()) + "(...)";
+        return std::string(tok->getText());
+    }
+
+    class Folder {
+
+    public:
+        Folder(Arena &arena): _arena{arena}, _changes{0} {}
+
+        int changes() const { return _changes; }
+
+        ArenaPtr<ExprNode> fold(ArenaPtr<ExprNode> node) {
+
+            ArenaPtr<ExprNode> *left = nullptr, *right = nullptr;
+
+            if ( auto infix = dynamic_cast<InfixExprNode *>(node.get()) ) {
+                left = &infix->_left;
+                right = &infix->_right;
+            } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node.get()) ) {
+                left = &comparison->_left;
+                right = &comparison->_right;
+            } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(node.get()) ) {
+                left = &boolean->_left;
+                right = &boolean->_right;
+            } else {
+                return node;
+            }
+
+            *left = fold(std::move(*left));
+            if ( *right != nullptr )
+                *right = fold(std::move(*right));
+
+            int l = literalType(left->get());
+            int r = *right == nullptr ? UNKNOWN : literalType(right->get());
+
+            if ( l != UNKNOWN && ( *right == nullptr || r != UNKNOWN ) && safeToFold(node.get(), l, r) ) {
+                _changes++;
+                return literal(node.get());
+            }
+
+            return simplify(std::move(node), *left, *right);
+        }
+
+    private:
+        // Applies the identities in Fold.hpp.
+        ArenaPtr<ExprNode> simplify(ArenaPtr<ExprNode> node, ArenaPtr<ExprNode> &left, ArenaPtr<ExprNode> &right) {
+
+            const Token *tok = node->token();
+
+            if ( dynamic_cast<InfixExprNode *>(node.get()) && right != nullptr ) {
+
+                bool intLeft = staticType(left.get()) == TypeDescriptor::INTEGER;
+                bool intRight = staticType(right.get()) == TypeDescriptor::INTEGER;
+
+                bool mul = tok->isMultiplicationOperator(), div = tok->isDivisionOperator();
+                bool add = tok->isAdditionOperator(), sub = tok->isSubtractionOperator();
+
+                // x * 1, x / 1, x + 0, x - 0
+                if ( intLeft && ( ( (mul || div) && isInt(right.get(), 1) ) || ( (add || sub) && isInt(right.get(), 0) ) ) ) {
+                    _changes++;
+                    return std::move(left);
+                }
+
+                // 1 * x, 0 + x
+                if ( intRight && ( ( mul && isInt(left.get(), 1) ) || ( add && isInt(left.get(), 0) ) ) ) {
+                    _changes++;
+                    return std::move(right);
+                }
+            }
+
+            if ( tok->isNot() && dynamic_cast<BooleanExprNode *>(node.get()) && left->token()->isNot() ) {
+                auto inner = dynamic_cast<BooleanExprNode *>(left.get());
+                if ( inner != nullptr && staticType(inner->_left.get()) == TypeDescriptor::BOOL ) {
+                    _changes++;
+                    return std::move(inner->_left);
+                }
+            }
+
+            return node;
+        }
+
+        // Evaluates `node` once and returns the equivalent literal.
+        ArenaPtr<ExprNode> literal(ExprNode *node) {
+
+            auto value = node->evaluate(_noVariables);
+
+            Token tok;
+            tok.setSpan(node->token()->span());
+
+            switch ( value.type() ) {
+                case TypeDescriptor::INTEGER:
+                    tok.setWholeNumber( Descriptor::Int::getIntValue(value) );
+                    return _arena.make<WholeNumber>(tok);
+
+                case TypeDescriptor::DOUBLE:
+                    tok.setFloat( Descriptor::Double::getDoubleValue(value) );
+                    return _arena.make<Double>(tok);
+
+                case TypeDescriptor::BOOL:
+                    tok.setWholeNumber( Descriptor::Bool::getBoolValue(value) );
+                    return _arena.make<BoolLiteral>(tok);
+
+                default:
+                    // The node copies the text; it is computed, not a
+                    // literal, so it isn't interned.
+                    tok.setString( Descriptor::String::getStringValue(value) );
+                    return _arena.make<StringExp>(tok, _arena);
+            }
+        }
+
+        Arena &_arena;
+        SymTab _noVariables;
+        int _changes;
+    };
+
+    ExprSlotVisitor folder(Folder &f, bool log) {
+        return [&f, log](ArenaPtr<ExprNode> &slot) {
+            int before = f.changes();
+            std::string original = log ? render(slot.get()) : std::string();
+            unsigned line = slot->token()->span().line;
+
+            slot = f.fold(std::move(slot));
+
+            if ( log && f.changes() != before )
+                std::cout << "fold line " << line << ": " << original << "  =>  " << render(slot.get()) << std::endl;
+        };
+    }
+}
+
+namespace Passes {
+
+    int fold(Statements &stmts, Arena &arena, bool log) {
+        Folder f(arena);
+        stmts.visitExprs(folder(f, log));
+        return f.changes();
+    }
+
+    int fold(Statement &stmt, Arena &arena, bool log) {
+        Folder f(arena);
+        stmt.visitExprs(folder(f, log));
+        return f.changes();
+    }
+};
@@ -0,0 +1,27 @@
+#ifndef __FOLD_HPP
+#define __FOLD_HPP
+
+#include "../Arena.hpp"
+#include "../statements/Statement.hpp"
+
+namespace Passes {
+
+    // Constant folding. Every subexpression made only of literals whose
+    // evaluation can neither fail, print nor overflow (so not 1 / 0,
+    // "a" * 2, 1 + "a" or a product past 2**63) is evaluated once, here,
+    // and replaced by a single literal node. Then the identities x * 1,
+    // 1 * x, x / 1, x + 0, 0 + x and x - 0 are applied where x is
+    // statically an integer, and not not x where x is statically a bool.
+    // Static types are the tags a prior Passes::inferTypes left (main runs
+    // one on a scratch environment first); untagged, only what the node's
+    // kind proves is known (comparison and boolean expressions are bools).
+    //
+    // New nodes go in `arena`. With `log`, each rewritten expression is
+    // printed before and after. Returns the number of nodes replaced.
+    int fold(Statements &stmts, Arena &arena, bool log);
+
+    // The same, for one top-level statement.
+    int fold(Statement &stmt, Arena &arena, bool log);
+};
+
+#endif
@@ -0,0 +1,222 @@
+#include <unordered_map>
+
+#include "Infer.hpp"
+
+namespace {
+
+    using Types = std::uint8_t;
+
+    const Types NONE = 0;
+    const Types NUMBERS = 1 << TypeDescriptor::INTEGER | 1 << TypeDescriptor::DOUBLE;
+
+    Types only(int type) { return 1 << type; }
+
+    // The result of `lhs op rhs` for operands validTypeOp accepts, as
+    // the arithmetic kernels in Dispatch.cpp compute it.
+    Types arithmetic(int lhs, int rhs, const Token *op) {
+        if ( lhs == TypeDescriptor::STRING && rhs == TypeDescriptor::STRING && op->isAdditionOperator() )
+            return only(TypeDescriptor::STRING);
+        if ( lhs == TypeDescriptor::DOUBLE && rhs == TypeDescriptor::DOUBLE )
+            return only(TypeDescriptor::DOUBLE);
+        return only(TypeDescriptor::INTEGER);
+    }
+
+    class Inferrer {
+
+    public:
+        Inferrer(Passes::TypeEnv &env):
+            _env{env},
+            _typed{0}
+        {}
+
+        int typed() const { return _typed; }
+
+        void infer(Statements &stmts) {
+            for (auto &&stmt : stmts._statements) {
+                Statement *s = stmt.get();
+
+                if ( dynamic_cast<FunctionDefinition *>(s) )
+                    continue;
+
+                if ( auto assign = dynamic_cast<AssignStmt *>(s) ) {
+                    Types rhs = NONE;
+                    assign->visitExprs([&](ArenaPtr<ExprNode> &slot) { rhs = infer(slot.get()); });
+                    write(assign->variable(), rhs);
+                } else if ( auto ifStatement = dynamic_cast<IfStatement *>(s) ) {
+                    infer(*ifStatement);
+                } else if ( auto range = dynamic_cast<RangeStmt *>(s) ) {
+                    infer(*range);
+                } else {
+                    s->visitExprs([this](ArenaPtr<ExprNode> &slot) { infer(slot.get()); });
+                }
+            }
+        }
+
+    private:
+        // Where the branches meet, a variable may hold what any branch
+        // left in it, or what it held before if some path assigns nothing.
+        void infer(IfStatement &ifStatement) {
+            std::unordered_map<Symbol, std::pair<Types, int>> merged;
+            int paths = 0;
+
+            auto branch = [&](Statements &suite) {
+                std::size_t mark = _trail.size();
+                infer(suite);
+                for (auto &&written : undo(mark)) {
+                    auto &m = merged[written.first];
+                    m.first |= written.second;
+                    m.second++;
+                }
+                paths++;
+            };
+
+            if ( ifStatement.ifClause() != nullptr ) {
+                Clause &clause = ifStatement.ifClause()->clause();
+                infer(clause.first.get());
+                branch(*clause.second);
+            }
+            if ( ifStatement.elifClauses() != nullptr ) {
+                for (auto &&clause : ifStatement.elifClauses()->clauses()) {
+                    infer(clause.first.get());
+                    branch(*clause.second);
+                }
+            }
+            if ( ifStatement.elseClause() != nullptr )
+                branch(*ifStatement.elseClause()->suite());
+            else
+                paths++;
+
+            for (auto &&m : merged) {
+                Types types = m.second.first;
+                if ( m.second.second < paths )
+                    types |= _env[m.first];
+                write(m.first, types);
+            }
+        }
+
+        // The loop variable is an integer at the head (the increment
+        // dies on anything else) and undefined after the loop.
+        void infer(RangeStmt &range) {
+            for (auto &&item : range.testList())
+                infer(item.get());
+
+            Symbol counter = range.variable();
+            write(counter, only(TypeDescriptor::INTEGER));
+
+            bool grew = true;
+            while ( grew ) {
+                grew = false;
+                std::size_t mark = _trail.size();
+                range.visitSuites([this](Statements &body) { infer(body); });
+
+                for (auto &&written : undo(mark)) {
+                    Types head = _env[written.first];
+                    if ( written.first != counter && (head | written.second) != head ) {
+                        write(written.first, head | written.second);
+                        grew = true;
+                    }
+                }
+            }
+
+            write(counter, NONE);
+        }
+
+        // Function call arguments are never evaluated, so calls are not
+        // entered.
+        Types infer(ExprNode *node) {
+            if ( node == nullptr )
+                return NONE;
+
+            Types types = typeOf(node);
+
+            int type = ExprNode::UNTYPED;
+            for (int t = TypeDescriptor::INTEGER; t <= TypeDescriptor::STRING; t++)
+                if ( types == only(t) )
+                    type = t;
+
+            node->setStaticType(type);
+            if ( type != ExprNode::UNTYPED )
+                _typed++;
+            return types;
+        }
+
+        Types typeOf(ExprNode *node) {
+            if ( dynamic_cast<WholeNumber *>(node) || dynamic_cast<FunctionCall *>(node) )
+                return only(TypeDescriptor::INTEGER);
+            if ( dynamic_cast<Double *>(node) )
+                return only(TypeDescriptor::DOUBLE);
+            if ( dynamic_cast<StringExp *>(node) )
+                return only(TypeDescriptor::STRING);
+            if ( dynamic_cast<BoolLiteral *>(node) )
+                return only(TypeDescriptor::BOOL);
+            if ( auto variable = dynamic_cast<Variable *>(node) )
+                return _env[variable->token()->getSymbol()];
+
+            if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+                Types lhs = infer(infix->_left.get());
+
+                if ( infix->_right == nullptr )
+                    return infix->token()->isSubtractionOperator() ? lhs & NUMBERS : NONE;
+
+                Types rhs = infer(infix->_right.get());
+                Types result = NONE;
+
+                for (int l = TypeDescriptor::INTEGER; l <= TypeDescriptor::STRING; l++)
+                    for (int r = TypeDescriptor::INTEGER; r <= TypeDescriptor::STRING; r++)
+                        if ( (lhs & only(l)) && (rhs & only(r)) && Descriptor::validTypeOp(l, r) )
+                            result |= arithmetic(l, r, infix->token());
+                return result;
+            }
+
+            if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) ) {
+                infer(comparison->_left.get());
+                infer(comparison->_right.get());
+                return only(TypeDescriptor::BOOL);
+            }
+            if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) ) {
+                infer(boolean->_left.get());
+                infer(boolean->_right.get());
+                return only(TypeDescriptor::BOOL);
+            }
+
+            return NONE;
+        }
+
+        // Writes are logged so a branch or loop body can be walked and
+        // then rolled back, leaving what it wrote to be merged.
+        void write(Symbol s, Types types) {
+            _trail.emplace_back(s, _env[s]);
+            _env[s] = types;
+        }
+
+        // Rolls the environment back to `mark`; returns the types each
+        // variable written since then was left with.
+        std::unordered_map<Symbol, Types> undo(std::size_t mark) {
+            std::unordered_map<Symbol, Types> written;
+
+            while ( _trail.size() > mark ) {
+                auto &entry = _trail.back();
+                written.emplace(entry.first, _env[entry.first]);
+                _env[entry.first] = entry.second;
+                _trail.pop_back();
+            }
+            return written;
+        }
+
+        Passes::TypeEnv &_env;
+        std::vector<std::pair<Symbol, Types>> _trail;
+        int _typed;
+    };
+};
+
+namespace Passes {
+
+    int inferTypes(Statements &stmts, TypeEnv &env) {
+        if ( env.size() < Symbols::count() )
+            env.resize(Symbols::count(), NONE);
+
+        Inferrer i{env};
+        i.infer(stmts);
+        return i.typed();
+    }
+};
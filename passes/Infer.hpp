@@ -0,0 +1,33 @@
+#ifndef __INFER_HPP
+#define __INFER_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "../statements/Statement.hpp"
+
+namespace Passes {
+
+    // What each global may hold at some point of the program, indexed by
+    // Symbol: a set of TypeDescriptor::types, one bit per type. No bits
+    // means the variable is undefined there.
+    using TypeEnv = std::vector<std::uint8_t>;
+
+    // Flow-sensitive type inference. Walks the statements in execution
+    // order, tracking the types each assignment leaves in its variable;
+    // if/elif/else branches are merged where they meet and a loop body is
+    // re-walked until the types at its head stop growing. Every expression
+    // node whose value can only be one type is tagged with it
+    // (ExprNode::setStaticType); the evaluator runs the kernel for typed
+    // operands inline instead of dispatching on their type tags
+    // (Dispatch.hpp). A tag says what the node yields if it yields at all:
+    // reading an undefined variable still fails at run time.
+    //
+    // `env` is what holds before `stmts` runs, and is left as what holds
+    // after it, so top-level statements streamed one at a time can share
+    // one. Function bodies never run and are skipped. Returns the number
+    // of nodes tagged.
+    int inferTypes(Statements &stmts, TypeEnv &env);
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "Resolve.hpp"
+
+namespace {
+
+    class Resolver {
+
+    public:
+        Resolver():
+            _bound{0}
+        {}
+
+        int bound() const { return _bound; }
+
+        void resolve(Statements &stmts) {
+            for (auto &&stmt : stmts._statements) {
+                Statement *s = stmt.get();
+
+                if ( dynamic_cast<FunctionDefinition *>(s) )
+                    continue;
+
+                if ( auto assign = dynamic_cast<AssignStmt *>(s) )
+                    bind(assign);
+                else if ( auto range = dynamic_cast<RangeStmt *>(s) )
+                    bind(range);
+
+                // A compound statement's visitExprs() would also reach any
+                // def nested in it, so only its conditions and range
+                // arguments are taken here and its suites are handled
+                // statement by statement.
+                if ( auto ifStatement = dynamic_cast<IfStatement *>(s) ) {
+                    if ( ifStatement->ifClause() != nullptr )
+                        resolve(ifStatement->ifClause()->clause().first.get());
+                    if ( ifStatement->elifClauses() != nullptr )
+                        for (auto &&clause : ifStatement->elifClauses()->clauses())
+                            resolve(clause.first.get());
+                } else if ( auto range = dynamic_cast<RangeStmt *>(s) ) {
+                    for (auto &&item : range->testList())
+                        resolve(item.get());
+                } else {
+                    s->visitExprs([this](ArenaPtr<ExprNode> &slot) { resolve(slot.get()); });
+                }
+
+                s->visitSuites([this](Statements &inner) { resolve(inner); });
+            }
+        }
+
+    private:
+        // Function call arguments are never evaluated, so calls are not
+        // entered.
+        void resolve(ExprNode *node) {
+            if ( node == nullptr )
+                return;
+
+            if ( auto variable = dynamic_cast<Variable *>(node) ) {
+                bind(variable);
+            } else if ( auto infix = dynamic_cast<InfixExprNode *>(node) ) {
+                resolve(infix->_left.get());
+                resolve(infix->_right.get());
+            } else if ( auto comparison = dynamic_cast<ComparisonExprNode *>(node) ) {
+                resolve(comparison->_left.get());
+                resolve(comparison->_right.get());
+            } else if ( auto boolean = dynamic_cast<BooleanExprNode *>(node) ) {
+                resolve(boolean->_left.get());
+                resolve(boolean->_right.get());
+            }
+        }
+
+        template <class Node>
+        void bind(Node *node) {
+            node->bindSlot();
+            _bound++;
+        }
+
+        int _bound;
+    };
+};
+
+namespace Passes {
+
+    int resolveSlots(Statements &stmts, SymTab &symTab) {
+        symTab.reserveSlots(Symbols::count());
+
+        Resolver r;
+        r.resolve(stmts);
+        return r.bound();
+    }
+};
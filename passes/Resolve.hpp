@@ -0,0 +1,24 @@
+#ifndef __RESOLVE_HPP
+#define __RESOLVE_HPP
+
+#include "../SymTab.hpp"
+#include "../statements/Statement.hpp"
+
+namespace Passes {
+
+    // Slot resolution. Symbols are dense, program-wide IDs and SymTab keeps
+    // the globals in a vector indexed by them, so a global variable's
+    // Symbol already is its slot. This pass makes every slot the program
+    // names addressable up front (SymTab::reserveSlots), then binds the
+    // Variables, AssignStmts and RangeStmts of the global frame to their
+    // slots. Bound nodes index the frame directly instead of going through
+    // isDefined(), getValueFor() and setValueFor(), which check the scope
+    // stack, the bounds and the definedness again on every access.
+    //
+    // Function bodies are left alone: they would run in a frame of their
+    // own. Must run while `symTab` has no scope open. Returns the number of
+    // nodes bound.
+    int resolveSlots(Statements &stmts, SymTab &symTab);
+};
+
+#endif
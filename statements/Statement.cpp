@@ -4,14 +4,25 @@
 #include <algorithm>
 
 #include "Statement.hpp"
+#include "../ProgramCache.hpp"
 
 // START "STATEMENT"
 Statement::Statement() {}
+
+// An if/elif condition; one proven BOOL (passes/Infer.hpp) is read as is.
+static bool conditionHolds(ExprNode *condition, SymTab &symTab) {
+    auto value = condition->evaluate(symTab);
+
+    if ( condition->staticType() == TypeDescriptor::BOOL )
+        return value._value.boolValue;
+    return Descriptor::Bool::getBoolValue(value);
+}
 // END "STATEMENT"
 
 
-AssignStmt::AssignStmt(std::string lhsVar, std::unique_ptr<ExprNode> rhsExpr):
+AssignStmt::AssignStmt(Symbol lhsVar, ArenaPtr<ExprNode> rhsExpr):
     _lhsVariable{lhsVar},
+    _slotted{false},
     _rhsExpression{std::move(rhsExpr)}
 {}
 
@@ -29,18 +40,31 @@ void AssignStmt::evaluate(SymTab &symTab) {
         std::cout << "void AssignStmt::evaluate(SymTab &symTab)" << std::endl;
 
     auto rhs = _rhsExpression->evaluate(symTab);
-    symTab.setValueFor(_lhsVariable, std::move(rhs));
+    if ( _slotted )
+        symTab.slot(_lhsVariable) = std::move(rhs);
+    else
+        symTab.setValueFor(_lhsVariable, std::move(rhs));
 }
 
 void AssignStmt::dumpAST(std::string spaces) {
     std::cout << spaces << "AssignStmt  ";
     std::cout << this << '\t';
-    std::cout  << _lhsVariable << " = ";
+    std::cout  << Symbols::name(_lhsVariable) << " = ";
     _rhsExpression->print();
     std::cout << std::endl;
     _rhsExpression->dumpAST(spaces + '\t');
 
 }
+
+void AssignStmt::visitExprs(const ExprSlotVisitor &visit) {
+    visit(_rhsExpression);
+}
+
+void AssignStmt::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::ASSIGN_STMT);
+    out.symbol(_lhsVariable);
+    out.node(_rhsExpression.get());
+}
 // END "ASSIGNMENTSTATEMENT"
 
 // START "IFSTATEMENT"
@@ -55,15 +79,15 @@ IfStatement::~IfStatement() {
         std::cout << "~IfStatement()" << std::endl;
 }
 
-void IfStatement::addIfStmt(std::unique_ptr<IfStmt> ifStmt) {
+void IfStatement::addIfStmt(ArenaPtr<IfStmt> ifStmt) {
     _if = std::move(ifStmt);
 }
 
-void IfStatement::addElifStmt(std::unique_ptr<ElifStmt> elifStmt) {
+void IfStatement::addElifStmt(ArenaPtr<ElifStmt> elifStmt) {
     _elif = std::move(elifStmt);
 }
 
-void IfStatement::addElseStmt(std::unique_ptr<ElseStmt> elseStmt) {
+void IfStatement::addElseStmt(ArenaPtr<ElseStmt> elseStmt) {
     _else = std::move(elseStmt);
 }
 
@@ -99,10 +123,36 @@ void IfStatement::dumpAST(std::string spaces) {
         _else->dumpAST(spaces + '\t');
 
 }
+
+void IfStatement::visitExprs(const ExprSlotVisitor &visit) {
+    if ( _if != nullptr )
+        _if->visitExprs(visit);
+    if ( _elif != nullptr )
+        _elif->visitExprs(visit);
+    if ( _else != nullptr )
+        _else->visitExprs(visit);
+}
+
+void IfStatement::visitSuites(const SuiteVisitor &visit) {
+    if ( _if != nullptr )
+        visit(*_if->clause().second);
+    if ( _elif != nullptr )
+        for ( auto &&item : _elif->clauses() )
+            visit(*item.second);
+    if ( _else != nullptr )
+        visit(*_else->suite());
+}
+
+void IfStatement::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::IF_STATEMENT);
+    out.node(_if.get());
+    out.node(_elif.get());
+    out.node(_else.get());
+}
 // END "IFSTATEMENT"
 
 // START "PRINTSTATEMENT"
-PrintStatement::PrintStatement(std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testList):
+PrintStatement::PrintStatement(ArenaPtr<ExprList> testList):
     _testList{std::move(testList)}
 {}
 
@@ -117,7 +167,7 @@ void PrintStatement::evaluate(SymTab &symTab) {
         std::cout << "void PrintStatement::evaluate(SymTab &symTab)" << std::endl;
 
     for_each(_testList->begin(), _testList->end(), [&](auto &&item) {
-        Descriptor::printValue( item->evaluate(symTab).get() );
+        Descriptor::printValue( item->evaluate(symTab) );
         std::cout << " ";
     });
     std::cout << std::endl;
@@ -130,11 +180,22 @@ void PrintStatement::dumpAST(std::string spaces) {
         item->dumpAST(spaces + '\t');
     });
 }
+
+void PrintStatement::visitExprs(const ExprSlotVisitor &visit) {
+    for (auto &&item : *_testList)
+        visit(item);
+}
+
+void PrintStatement::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::PRINT_STATEMENT);
+    out.exprList(_testList.get());
+}
 // END "PRINTSTATEMENT"
 
 //START "RangeStmt"
-RangeStmt::RangeStmt(std::string id):
-    _id{id}
+RangeStmt::RangeStmt(Symbol id):
+    _id{id},
+    _slotted{false}
 {}
 
 RangeStmt::~RangeStmt() {
@@ -150,11 +211,11 @@ void RangeStmt::evaluate(SymTab &symTab) {
     parseTestList(symTab);
 
     if ( symTab.isDefined( _id ) ) {
-        std::cout << "Variable " << _id << " is defined - dying (( FIX )) " << std::endl;
+        std::cout << "Variable " << Symbols::name(_id) << " is defined - dying (( FIX )) " << std::endl;
         exit(1);
     }
 
-    int start, end, step;
+    std::int64_t start, end, step;
 
     start = _start.value_or(0);
 
@@ -171,14 +232,14 @@ void RangeStmt::evaluate(SymTab &symTab) {
  
     if (start > end && step < 0) {
 
-        for (; Descriptor::Int::getIntValue(symTab.getValueFor(_id)) > end; Descriptor::Int::incrementByN(step, symTab.getValueFor(_id))) {
+        for (; Descriptor::Int::getIntValue(counter(symTab)) > end; Descriptor::Int::incrementByN(step, counter(symTab))) {
             _forBody->evaluate(symTab);
         }
 
 
     } else if (start < end && 1 <= step) {
 
-        for (; Descriptor::Int::getIntValue(symTab.getValueFor(_id)) < end; Descriptor::Int::incrementByN(step, symTab.getValueFor(_id))) {
+        for (; Descriptor::Int::getIntValue(counter(symTab)) < end; Descriptor::Int::incrementByN(step, counter(symTab))) {
             _forBody->evaluate(symTab);
         }
 
@@ -204,6 +265,29 @@ void RangeStmt::dumpAST(std::string space) {
     _forBody->dumpAST(space + '\t');
 }
 
+void RangeStmt::visitExprs(const ExprSlotVisitor &visit) {
+    for (auto &&item : *_testList)
+        visit(item);
+    _forBody->visitExprs(visit);
+}
+
+// The body may assign to the loop variable, so it is looked up afresh
+// on every test and increment.
+Value &RangeStmt::counter(SymTab &symTab) {
+    return _slotted ? symTab.slot(_id) : *symTab.getValueFor(_id);
+}
+
+void RangeStmt::visitSuites(const SuiteVisitor &visit) {
+    visit(*_forBody);
+}
+
+void RangeStmt::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::RANGE_STMT);
+    out.symbol(_id);
+    out.exprList(_testList.get());
+    out.statements(_forBody.get());
+}
+
 void RangeStmt::parseTestList(SymTab &symTab) {
 
     if ( _testList->size() > 3 ) {
@@ -215,36 +299,36 @@ void RangeStmt::parseTestList(SymTab &symTab) {
     for_each(_testList->begin(), _testList->end(), [&, this](auto &item) {
 
         auto desc = item->evaluate(symTab);
-        int intVal = Descriptor::Int::getIntValue(desc.get());
+        std::int64_t intVal = Descriptor::Int::getIntValue(desc);
 
-        editOptionals(i, std::optional<int>{ intVal });
+        editOptionals(i, std::optional<std::int64_t>{ intVal });
 
         i++;
 
     });
 
     for (; i < 3; i++)
-        editOptionals(i, std::optional<int>{ std::nullopt });
+        editOptionals(i, std::optional<std::int64_t>{ std::nullopt });
 
     // Adjust
     if ( !_end.has_value() && !_step.has_value() ) {
         _end = _start;
-        _start = std::optional<int>{};
+        _start = std::optional<std::int64_t>{};
     }
 }
 
 // void RangeStmt::addStatements(std::unique_ptr<GroupedStatements> gs) {
 //     _forBody = std::move(gs);
 // }
-void RangeStmt::addStatements(std::unique_ptr<Statements> stmts) {
+void RangeStmt::addStatements(ArenaPtr<Statements> stmts) {
     _forBody = std::move(stmts);
 }
 
-void RangeStmt::addTestList(std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> testList) {
+void RangeStmt::addTestList(ArenaPtr<ExprList> testList) {
     _testList = std::move(testList);
 }
 
-void RangeStmt::editOptionals(int which, std::optional<int> opt) {
+void RangeStmt::editOptionals(int which, std::optional<std::int64_t> opt) {
 
     if ( which == 0 )
         _start = opt;
@@ -260,13 +344,13 @@ void RangeStmt::editOptionals(int which, std::optional<int> opt) {
 
 //START FunctionDefinition
 FunctionDefinition::FunctionDefinition(
-    std::string funcName,
-    std::vector<std::string> paramList,
-    std::unique_ptr<Statements> SUITE_NOT_FUNC_SUITE_FIX,
+    Symbol funcName,
+    ArenaVector<Symbol> paramList,
+    ArenaPtr<Statements> SUITE_NOT_FUNC_SUITE_FIX,
     bool hasBeenAddedToSymTab):
-    _funcName{funcName},
     _paramList{paramList},
     _SUITE_NOT_FUNC_SUITE_FIX{std::move(SUITE_NOT_FUNC_SUITE_FIX)},
+    _funcName{funcName},
     _hasBeenAddedToSymTab{hasBeenAddedToSymTab}
 {}
 
@@ -281,8 +365,8 @@ void FunctionDefinition::evaluate(SymTab &symTab) {
 }
 
 void FunctionDefinition::dumpAST(std::string spaces) {
-    std::cout << spaces << "FunctionDef: " << _funcName << " " << this << " ( ";
-    for_each(_paramList.begin(), _paramList.end(), [](auto &str) { std::cout << str << " "; });
+    std::cout << spaces << "FunctionDef: " << Symbols::name(_funcName) << " " << this << " ( ";
+    for_each(_paramList.begin(), _paramList.end(), [](auto &param) { std::cout << Symbols::name(param) << " "; });
     std::cout << ")" << std::endl;
 
     if (_SUITE_NOT_FUNC_SUITE_FIX == nullptr ) {
@@ -292,11 +376,31 @@ void FunctionDefinition::dumpAST(std::string spaces) {
     }
 }
 
+void FunctionDefinition::visitExprs(const ExprSlotVisitor &visit) {
+    if (_SUITE_NOT_FUNC_SUITE_FIX != nullptr)
+        _SUITE_NOT_FUNC_SUITE_FIX->visitExprs(visit);
+}
+
+void FunctionDefinition::visitSuites(const SuiteVisitor &visit) {
+    if (_SUITE_NOT_FUNC_SUITE_FIX != nullptr)
+        visit(*_SUITE_NOT_FUNC_SUITE_FIX);
+}
+
+void FunctionDefinition::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::FUNCTION_DEFINITION);
+    out.symbol(_funcName);
+    out.u32(static_cast<std::uint32_t>(_paramList.size()));
+    for (auto param : _paramList)
+        out.symbol(param);
+    out.statements(_SUITE_NOT_FUNC_SUITE_FIX.get());
+    out.u8(_hasBeenAddedToSymTab);
+}
+
 
 //END FunctionDefinition
 
 //START FUNCTIONCALL
-FunctionCallStatement::FunctionCallStatement(std::unique_ptr<ExprNode> exprNodeCall):
+FunctionCallStatement::FunctionCallStatement(ArenaPtr<ExprNode> exprNodeCall):
     _exprNodeCall{std::move(exprNodeCall)}
 {}
 
@@ -309,18 +413,29 @@ void FunctionCallStatement::dumpAST(std::string spaces) {
     _exprNodeCall->dumpAST(spaces + "\t");
 }
 
+void FunctionCallStatement::visitExprs(const ExprSlotVisitor &visit) {
+    visit(_exprNodeCall);
+}
+
+void FunctionCallStatement::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::FUNCTION_CALL_STATEMENT);
+    out.node(_exprNodeCall.get());
+}
+
 
 //END FUNCTIONCALL
 
 // START "STATEMENTS"
-Statements::Statements() {}
+Statements::Statements(Arena &arena):
+    _statements(arena)
+{}
 
 Statements::~Statements() {
     if (destructor)
         std::cout << "~Statements()" << std::endl;
 }
 
-void Statements::addStatement(std::unique_ptr<Statement> statement) {
+void Statements::addStatement(ArenaPtr<Statement> statement) {
     _statements.push_back(std::move(statement));
 }
 
@@ -343,6 +458,18 @@ void Statements::dumpAST(std::string spaces) {
     for_each(_statements.begin(), _statements.end(), [&spaces](auto &s) { s->dumpAST(spaces + '\t'); });
 
 }
+
+void Statements::visitExprs(const ExprSlotVisitor &visit) {
+    for (auto &&s: _statements)
+        s->visitExprs(visit);
+}
+
+void Statements::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::STATEMENTS);
+    out.u32(static_cast<std::uint32_t>(_statements.size()));
+    for (auto &&s: _statements)
+        s->serialize(out);
+}
 // END "STATEMENTS"
 
 
@@ -360,8 +487,8 @@ Comparison::Comparison() {}
 //     _if.second = std::move(stmts);
 // }
 IfStmt::IfStmt(
-    std::unique_ptr<ExprNode> comp,
-    std::unique_ptr<Statements> stmts
+    ArenaPtr<ExprNode> comp,
+    ArenaPtr<Statements> stmts
 ) {
     _if.first = std::move(comp);
     _if.second = std::move(stmts);
@@ -377,7 +504,7 @@ bool IfStmt::evaluate(SymTab &symTab) {
     if (debug)
         std::cout << "bool IfStmt::evaluate(SymTab &symTab)" << std::endl;
 
-    if ( Descriptor::Bool::getBoolValue( _if.first->evaluate(symTab).get() ) ) {
+    if ( conditionHolds(_if.first.get(), symTab) ) {
         _if.second->evaluate(symTab);
         return true;
     }
@@ -391,11 +518,24 @@ void IfStmt::dumpAST(std::string spaces) {
     _if.second->dumpAST(spaces + "\t");
 
 }
+
+void IfStmt::visitExprs(const ExprSlotVisitor &visit) {
+    visit(_if.first);
+    _if.second->visitExprs(visit);
+}
+
+void IfStmt::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::IF_STMT);
+    out.node(_if.first.get());
+    out.statements(_if.second.get());
+}
 // END "IF" 
 
 
 // START "ELIF"
-ElifStmt::ElifStmt() {}
+ElifStmt::ElifStmt(Arena &arena):
+    _elif(arena)
+{}
 
 ElifStmt::~ElifStmt() {
     if (destructor)
@@ -403,12 +543,12 @@ ElifStmt::~ElifStmt() {
 }
 
 // void ElifStmt::addStatement(std::unique_ptr<ExprNode> elif, std::unique_ptr<GroupedStatements> stmts) {
-void ElifStmt::addStatement(std::unique_ptr<ExprNode> elif, std::unique_ptr<Statements> stmts) {
+void ElifStmt::addStatement(ArenaPtr<ExprNode> elif, ArenaPtr<Statements> stmts) {
     _elif.push_back(
         std::pair<
-            std::unique_ptr<ExprNode>,
+            ArenaPtr<ExprNode>,
             // std::unique_ptr<GroupedStatements>
-            std::unique_ptr<Statements>
+            ArenaPtr<Statements>
         >{
             std::move(elif),
             std::move(stmts)
@@ -423,7 +563,7 @@ bool ElifStmt::evaluate(SymTab &symTab) {
         std::cout << "bool ElifStmt::evaluate(SymTab &symTab)" << std::endl;
 
     for ( auto &&item : _elif ) {
-        if ( Descriptor::Bool::getBoolValue( item.first->evaluate(symTab).get() ) ) {
+        if ( conditionHolds(item.first.get(), symTab) ) {
             item.second->evaluate(symTab);
             return true;
         }
@@ -440,6 +580,22 @@ void ElifStmt::dumpAST(std::string spaces) {
         s.second->dumpAST(spaces + "\t");
      });
 }
+
+void ElifStmt::visitExprs(const ExprSlotVisitor &visit) {
+    for ( auto &&item : _elif ) {
+        visit(item.first);
+        item.second->visitExprs(visit);
+    }
+}
+
+void ElifStmt::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::ELIF_STMT);
+    out.u32(static_cast<std::uint32_t>(_elif.size()));
+    for ( auto &&item : _elif ) {
+        out.node(item.first.get());
+        out.statements(item.second.get());
+    }
+}
 // END "ELIF"
 
 
@@ -447,7 +603,7 @@ void ElifStmt::dumpAST(std::string spaces) {
 // ElseStmt::ElseStmt(std::unique_ptr<GroupedStatements> s):
 //     stmts{std::move(s)}
 // {}
-ElseStmt::ElseStmt(std::unique_ptr<Statements> s):
+ElseStmt::ElseStmt(ArenaPtr<Statements> s):
     _stmts{std::move(s)}
 {}
 
@@ -471,4 +627,13 @@ void ElseStmt::dumpAST(std::string spaces) {
     std::cout << this << "\t" << std::endl;
     _stmts->dumpAST(spaces + "\t");
 }
+
+void ElseStmt::visitExprs(const ExprSlotVisitor &visit) {
+    _stmts->visitExprs(visit);
+}
+
+void ElseStmt::serialize(ProgramWriter &out) {
+    out.tag(ProgramWriter::ELSE_STMT);
+    out.statements(_stmts.get());
+}
 // END "ELSE"
@@ -1,9 +1,11 @@
 #ifndef __STATEMENT_HPP
 #define __STATEMENT_HPP
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <optional>
+#include <functional>
 
 #include "../SymTab.hpp"
 #include "../ArithExpr.hpp"
@@ -14,7 +16,20 @@
 
 class IfStmt;
 class ElifStmt;
+class Statements;
 class ElseStmt;
+class ProgramWriter;
+
+// Called on every expression a statement owns, nested bodies included. The
+// slot is passed by reference so a pass can replace the expression in it.
+using ExprSlotVisitor = std::function<void(ArenaPtr<ExprNode> &)>;
+
+// Called on each suite (block of Statements) directly inside a statement:
+// loop and function bodies, and every if/elif/else branch.
+using SuiteVisitor = std::function<void(Statements &)>;
+
+// A condition and the suite it guards, as kept by IfStmt and ElifStmt.
+using Clause = std::pair<ArenaPtr<ExprNode>, ArenaPtr<Statements>>;
 
 class Statement {
 
@@ -24,38 +39,53 @@ public:
     virtual ~Statement() = default;
     virtual void evaluate(SymTab &symTab) = 0;
     virtual void dumpAST(std::string) = 0;
+    virtual void visitExprs(const ExprSlotVisitor &) = 0;
+    virtual void visitSuites(const SuiteVisitor &) {}
+    // Writes the node and its children for the ProgramCache.
+    virtual void serialize(ProgramWriter &) = 0;
 };
 
 
 class Statements {
 
 public:
-    Statements();
+    Statements(Arena &);
 
-    void addStatement(std::unique_ptr<Statement> statement);
+    void addStatement(ArenaPtr<Statement> statement);
     void evaluate(SymTab &symTab);
     ~Statements();
 
     void dumpAST(std::string);
+    void visitExprs(const ExprSlotVisitor &);
+    void serialize(ProgramWriter &);
 
     int length() { return _statements.size(); }
 
 public:
-    std::vector<std::unique_ptr<Statement>> _statements;
+    ArenaVector<ArenaPtr<Statement>> _statements;
 };
 
 class AssignStmt : public Statement {
 
 public:
     // AssignStmt(std::string, ExprNode *);
-    AssignStmt(std::string, std::unique_ptr<ExprNode>);
+    AssignStmt(Symbol, ArenaPtr<ExprNode>);
 
     virtual ~AssignStmt();
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
+
+    // Writes the variable's global slot directly (passes/Resolve.hpp).
+    void bindSlot() { _slotted = true; }
+
+    Symbol variable() const { return _lhsVariable; }
+
 private:
-    std::string _lhsVariable;
-    std::unique_ptr<ExprNode> _rhsExpression;
+    Symbol _lhsVariable;
+    bool _slotted;
+    ArenaPtr<ExprNode> _rhsExpression;
     // ExprNode *_rhsExpression;
 };
 
@@ -64,85 +94,112 @@ class IfStatement : public Statement {
 public:
     IfStatement();
 
-    void addIfStmt(std::unique_ptr<IfStmt>);
-    void addElifStmt(std::unique_ptr<ElifStmt>);
-    void addElseStmt(std::unique_ptr<ElseStmt>);
+    void addIfStmt(ArenaPtr<IfStmt>);
+    void addElifStmt(ArenaPtr<ElifStmt>);
+    void addElseStmt(ArenaPtr<ElseStmt>);
 
     virtual ~IfStatement();
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void visitSuites(const SuiteVisitor &);
+    virtual void serialize(ProgramWriter &);
+
+    // For passes that rewrite the branches; any of them may be empty.
+    ArenaPtr<IfStmt>   &ifClause()    { return _if; }
+    ArenaPtr<ElifStmt> &elifClauses() { return _elif; }
+    ArenaPtr<ElseStmt> &elseClause()  { return _else; }
 
 private:
-    std::unique_ptr<IfStmt>   _if;
-    std::unique_ptr<ElifStmt> _elif;
-    std::unique_ptr<ElseStmt> _else;
+    ArenaPtr<IfStmt>   _if;
+    ArenaPtr<ElifStmt> _elif;
+    ArenaPtr<ElseStmt> _else;
 };
 
 class PrintStatement : public Statement {
 
 public:
     // PrintStatement(std::string);
-    PrintStatement(std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
+    PrintStatement(ArenaPtr<ExprList>);
 
     virtual ~PrintStatement();
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
 
 private:
-    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
+    ArenaPtr<ExprList> _testList;
 };
 
 
 class RangeStmt : public Statement {
 
 public:
-    RangeStmt(std::string);
+    RangeStmt(Symbol);
 
     virtual ~RangeStmt();
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void visitSuites(const SuiteVisitor &);
+    virtual void serialize(ProgramWriter &);
 
     void parseTestList(SymTab &symTab);
     
     // void addStatements(std::unique_ptr<GroupedStatements>);
-    void addStatements(std::unique_ptr<Statements>);
+    void addStatements(ArenaPtr<Statements>);
     
-    void addTestList(std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>>);
-    void editOptionals(int, std::optional<int>);
+    void addTestList(ArenaPtr<ExprList>);
+    void editOptionals(int, std::optional<std::int64_t>);
+
+    // Keeps the loop variable in its global slot (passes/Resolve.hpp).
+    void bindSlot() { _slotted = true; }
+
+    Symbol variable() const { return _id; }
+    ExprList &testList() { return *_testList; }
 
 private:
-    std::string _id;
-    std::optional<int> _start, _end, _step;
+    Value &counter(SymTab &symTab);
+
+    Symbol _id;
+    bool _slotted;
+    std::optional<std::int64_t> _start, _end, _step;
 
     // std::unique_ptr<GroupedStatements> _forBody;
-    std::unique_ptr<Statements> _forBody;
+    ArenaPtr<Statements> _forBody;
 
-    std::unique_ptr<std::vector<std::unique_ptr<ExprNode>>> _testList;
+    ArenaPtr<ExprList> _testList;
 };
 
 class FunctionDefinition : public Statement {
 public:
-    FunctionDefinition(std::string, std::vector<std::string>, std::unique_ptr<Statements>, bool);
+    FunctionDefinition(Symbol, ArenaVector<Symbol>, ArenaPtr<Statements>, bool);
     virtual ~FunctionDefinition() = default;
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void visitSuites(const SuiteVisitor &);
+    virtual void serialize(ProgramWriter &);
 
-std::vector<std::string> _paramList;
-std::unique_ptr<Statements> _SUITE_NOT_FUNC_SUITE_FIX;
+ArenaVector<Symbol> _paramList;
+ArenaPtr<Statements> _SUITE_NOT_FUNC_SUITE_FIX;
 
 private:
-    std::string _funcName;
+    Symbol _funcName;
     bool _hasBeenAddedToSymTab;
 };
 
 class FunctionCallStatement : public Statement {
 public:
-    FunctionCallStatement(std::unique_ptr<ExprNode>);
+    FunctionCallStatement(ArenaPtr<ExprNode>);
     virtual ~FunctionCallStatement() = default;
     virtual void evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
 private:
-    std::unique_ptr<ExprNode> _exprNodeCall;
+    ArenaPtr<ExprNode> _exprNodeCall;
 };
  
 
@@ -153,6 +210,9 @@ public:
     virtual ~Comparison() = default;
     virtual bool evaluate(SymTab &symTab) = 0;
     virtual void dumpAST(std::string) = 0;
+    virtual void visitExprs(const ExprSlotVisitor &) = 0;
+    // Writes the node and its children for the ProgramCache.
+    virtual void serialize(ProgramWriter &) = 0;
 };
 
 class IfStmt : public Comparison {
@@ -165,41 +225,49 @@ public:
     // );
 
     IfStmt(
-        std::unique_ptr<ExprNode>,
-        std::unique_ptr<Statements>
+        ArenaPtr<ExprNode>,
+        ArenaPtr<Statements>
     );
 
     virtual ~IfStmt(); /* = default;*/
     virtual bool evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
+
+    Clause &clause() { return _if; }
 
 private: 
     std::pair<
-        std::unique_ptr<ExprNode>,
+        ArenaPtr<ExprNode>,
         // std::unique_ptr<GroupedStatements>
-        std::unique_ptr<Statements>
+        ArenaPtr<Statements>
     > _if;
 };
 
 class ElifStmt : public Comparison {
 
 public:
-    ElifStmt();
+    ElifStmt(Arena &);
     virtual ~ElifStmt(); /* = default*/;
 
     // void addStatement(std::unique_ptr<ExprNode>, std::unique_ptr<GroupedStatements>);
     // void addStatement(ExprNode *, std::unique_ptr<GroupedStatements>);
-    void addStatement(std::unique_ptr<ExprNode>, std::unique_ptr<Statements>);
+    void addStatement(ArenaPtr<ExprNode>, ArenaPtr<Statements>);
 
     virtual bool evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
+
+    ArenaVector<Clause> &clauses() { return _elif; }
  
 private: 
-    std::vector<
+    ArenaVector<
         std::pair<
-            std::unique_ptr<ExprNode>,
+            ArenaPtr<ExprNode>,
             // std::unique_ptr<GroupedStatements>
-            std::unique_ptr<Statements>
+            ArenaPtr<Statements>
         >
     > _elif;
 };
@@ -208,15 +276,19 @@ class ElseStmt : public Comparison {
 
 public:
     // ElseStmt(std::unique_ptr<GroupedStatements>);
-    ElseStmt(std::unique_ptr<Statements>);
+    ElseStmt(ArenaPtr<Statements>);
     virtual ~ElseStmt(); /* = default;*/
 
     virtual bool evaluate(SymTab &symTab);
     virtual void dumpAST(std::string);
+    virtual void visitExprs(const ExprSlotVisitor &);
+    virtual void serialize(ProgramWriter &);
+
+    ArenaPtr<Statements> &suite() { return _stmts; }
 
 private:
     // std::unique_ptr<GroupedStatements> stmts;
-    std::unique_ptr<Statements> _stmts;
+    ArenaPtr<Statements> _stmts;
 };
 
 
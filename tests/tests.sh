@@ -37,6 +37,21 @@ for file in $(ls | grep -v *.sh); do
         echo -e "${Green}$file passes${NC}"
     fi
 
+    # Piped, the program runs one top-level statement at a time.
+    PIPED_INTERPRETER=$(cat $file | timeout 2 ../statement.x)
+    if [[ $? -ne 0 ]]; then
+        echo -e "${RED}ERROR - $file FAIL piped${NC}"
+        continue;
+    fi
+
+    DIFF=$(diff <( echo $PIPED_INTERPRETER ) <( echo $PYTHON_INTERPRETER ))
+    if [[ -n $DIFF ]]; then
+        echo -e "${RED}Test failed piped on file $file${NC}"
+        echo "-- Diff --"
+        echo $DIFF
+        echo
+    fi
+
 done
 
 echo